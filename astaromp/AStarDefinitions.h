@@ -50,11 +50,17 @@ typedef childrenMap::iterator childrenMapIter;	///< iterator for childrenMap
 /// In addition to this pointer, the path's precost (cost without path length compensation),
 /// its length and a pointer to the SideInfo, which contains necessary info for the problem class
 /// are also stored.
+/// In lazy expansion mode, a path may be pending: its leaf node mPendingID is not yet evaluated, so mSideInfo
+/// (shared with other children of the same parent) and mPreCost still belong to the parent path.
+/// In memory-bounded mode, a path may be forgotten: its SideInfo is freed (mSideInfo is NULL) and it is regenerated
+/// from its nodes in the trie when it reaches the top of the search stack.
 struct path{
 	TrieNode* mLeaf;	///< pointer to the leaf node of the path
 	void* mSideInfo;	///< pointer to the SideInfo of the path (contents unknown to BaseAStar, used by BaseOMP)
  	unsigned int mPathLength;		///< length of a path
 	float mPreCost;			///< pre-cost of a path: cost without path length compensation (without the auxiliary function)
+	bool mPending;			///< true if the last node of the path is not evaluated yet (lazy expansion)
+	unsigned int mPendingID;	///< elementID of the last node of a pending path
 };
 
 typedef std::multimap<cost, path, less<cost> > searchStack;		///< list of active search paths ordered by ascending cost
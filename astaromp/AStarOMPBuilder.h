@@ -27,6 +27,7 @@ karahanoglu@sabanciuniv.edu,  burak.karahanoglu@gmail.com
 
 #include "BaseAStar.h"
 #include "BaseOMP.h"
+#include "BeamSearch.h"
 #include <time.h>
 #include <time.h>
 #include "GlobalUtil.h"
@@ -69,6 +70,9 @@ private:
 	/// Function to read pCols vectors of size pRows from the file pFileName)
 	int InitMatrixFromFile(float** pMatrix,  string &pFileName, int pRows, int pCols );
 
+	/// Function to initialize the fast transform operator
+	int initOperator( string &pRowsFileName );
+
 	/// Function to evaluate reconstruction of a single vector
 	void evaluateSingleVector(int VectorInd);
 
@@ -89,19 +93,33 @@ private:
 	int mI;		///< I: number of initial A*OMP paths
 	int mB;		///< B: number of expanded A*OMP branches per iteration 
 	int mP;		///< P: number of maximum search paths in the A* tree
+	bool mLazyExpansion;	///< lazy expansion: children are evaluated only when they reach the top of the search stack
+	bool mOMPFastPath;		///< OMP fast path: A* search is run only for vectors that OMP cannot reconstruct within mEps
+	long mMemoryBudget;		///< memory budget of the A* search in bytes (0 for no budget)
+	string mSearchMode;		///< search mode: astar (A* search) or beam (beam search)
+	int mW;			///< W: beam width (number of paths kept per level) in beam search mode
+	int mBatchSize;	///< number of vectors whose correlations with the dictionary are precomputed at once (0 if not used)
 
 	float **mX;		///< pointer to the matrix of target sparse vectors
 	float **mY;		///< pointer to the matrix of observed vectors
 	float **mDict;	///< pointer to the matrix containing the dictionary (holographic basis)
+	LinearOperator *mOperator;	///< pointer to the fast transform operator that replaces mDict (NULL if not used)
+	string mOperatorType;		///< sensing operator: matrix (mDict), hadamard or dct
 
 	bool* mExRec;	///< pointer to the vector for evaluation of exact reconstruction of test vectors
 	int mNoExRecVec;	///< number of exactly reconstructed vectors
 	float* mErr;		///< pointer to the reconstruction error of an individual vector
 	double mTime;		///< processing time for A*OMP
+	double mInitTime;	///< processing time for initialization of A* search (included in mTime)
+	int mNoInitializations;	///< number of vectors for which A* search is initialized
 	float* mNMSE;		///< pointer to the vector of normalized mean squared errors of test vectors
+	float* mLatency;	///< pointer to the vector of processing times of test vectors
+	float** mBatchCorr;	///< pointer to the inner products of the dictionary atoms with a batch of observed vectors (mBatchSize x mN)
+	double mBatchTime;	///< processing time for batch precomputation of correlations (included in mTime)
 
 	BaseOMP *mBaseOMP;		///< pointer to the instance of BaseOMP class
 	BaseAStar *mBaseAStar;	///< pointer to the instance of BaseAStar class 
+	BeamSearch *mBeamSearch;	///< pointer to the instance of BeamSearch class (NULL in A* search mode)
 
 	ofstream mRecVectOfstream;		///< ofstream for reconstructed vectors
 	bool mBinOutput;				///< parameter for selecting binary or text output
@@ -113,6 +131,15 @@ private:
 	int mNoBranchAdded;		///< total number of branches that are added to the tree during the search 
 	int mNoBranchIgnored;	///< total number of branches that are ignored (via Stack size pruning) during the search
 	int mNoBranchReplaced;	///< total number of branches that are replaced by their first extensions during the search
+	int mNoFullEvaluations;	///< total number of exact cost evaluations (QR update of a SideInfo) of expanded branches during the search
+	int mNoEvaluationsAvoided;	///< total number of branches that are never evaluated in lazy expansion mode
+	int mNoOMPVectors;		///< number of vectors resolved by OMP on the fast path
+	bool mSolvedByOMP;		///< states if the current vector is resolved by OMP on the fast path
+	int mNoPathsForgotten;	///< total number of paths whose SideInfo is freed to satisfy the memory budget
+	int mNoPathsRegenerated;	///< total number of forgotten paths that are regenerated
+	int mNoPathsDropped;	///< total number of paths dropped from the search to satisfy the memory budget
+	double mPeakMemory;		///< sum of the peak search memory of the vectors in bytes
+	long mMaxPeakMemory;	///< maximum peak search memory of a vector in bytes
 
 	bool mTargetVectorsProvided; ///< states if target vectors are provided
 	string mRecVectorsFileName;	///< filename for writing reconstructed vectors
@@ -27,7 +27,7 @@ timespec diff(timespec start, timespec end)
 	return temp;
 }
 
-timespec time1, time2;
+timespec time1, time2, time3, time4;
 
 // constructor
 AStarOMPBuilder::AStarOMPBuilder()
@@ -35,14 +35,18 @@ AStarOMPBuilder::AStarOMPBuilder()
 	mX = NULL;
 	mY = NULL;
 	mDict = NULL;
+	mOperator = NULL;
 
 	mExRec = NULL;
 	mNoExRecVec = NULL;	
 	mErr = NULL;
 	mNMSE = NULL;
+	mLatency = NULL;
+	mBatchCorr = NULL;
 
 	mBaseOMP = NULL;
 	mBaseAStar = NULL;
+	mBeamSearch = NULL;
 
 	mBinOutput = true;
 	mCompExactRec = true;
@@ -64,6 +68,12 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 	mK = (int) cf.Value("A*OMP_Parameters","K");  
 	mEps = (float) cf.Value("A*OMP_Parameters","Eps");
 	mInitPL = (int) cf.Value("A*OMP_Parameters","InitPL");
+	mOMPFastPath = ((int) cf.Value("A*OMP_Parameters","OMPFastPath",0) != 0);
+	mMemoryBudget = (long) (double) cf.Value("A*OMP_Parameters","MemoryBudget",0);
+	mLazyExpansion = ((int) cf.Value("A*OMP_Parameters","LazyExpansion",0) != 0);
+	mSearchMode = (string) cf.Value("A*OMP_Parameters","SearchMode","astar");
+	mW = (int) cf.Value("A*OMP_Parameters","BeamWidth",8);
+	mBatchSize = (int) cf.Value("A*OMP_Parameters","BatchSize",0);
 	mM = (int) cf.Value("Data_Parameters","M");  
 	mN = (int) cf.Value("Data_Parameters","N");  
 	mNoVectors = (int) cf.Value("Data_Parameters","NoVectors");  
@@ -75,6 +85,8 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 	string ResultsFileName = cf.Value("OutputFiles","ResultFile");
 	
 	string dictMode = cf.Value("Data_Parameters","DictMode");
+	mOperatorType = (string) cf.Value("Data_Parameters","SensingOperator","matrix");
+	string RowsFileName = cf.Value("Data_Parameters","OperatorRowsFileName","");
 
 	if((int) cf.Value("Data_Parameters","ReadTargetVectors"))
 		mTargetVectorsProvided = true;
@@ -89,7 +101,13 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 		cout << ResultsFileName<<"Cannot open result file..." << endl;
 	}
 
-	if(dictMode =="single")
+	if(mOperatorType != "matrix")
+	{
+		// the dictionary is a fast transform operator, DictMode and DictFileName are not used
+		dictMode = "operator";
+		mMultiDict = false;
+	}
+	else if(dictMode =="single")
 	{
 		mMultiDict = false;
 	}
@@ -108,6 +126,14 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 		}
 	}
 
+	if(mSearchMode == "beam" && mW < 1)
+	{
+		cout<<"Invalid BeamWidth in config file. Should be at least 1."<<endl;
+		cout<<"Terminating...";
+		mResultOfstream<<"Invalid BeamWidth in config file... should be at least 1.";
+		return 0;
+	}
+
 	// set auxiliary function mode
 	if(AuxFuncMode == "ADAP")
 		mAuxiliaryFunctionMode = ADAP;
@@ -117,12 +143,25 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 		mAuxiliaryFunctionMode = MUL;
 
 	// initialize data
-	mDict = allocateFloatMatrix(mN,mM);
+	if(dictMode != "operator")
+		mDict = allocateFloatMatrix(mN,mM);
 	mY = allocateFloatMatrix(mNoVectors,mM);
 
 	// read the dictionary (phi)
 	// read N vectors of size M (reads consecutive vectors from the binary file)
-	if(dictMode =="single")
+	if(dictMode =="operator")
+	{
+		cout<<"Reading operator rows : ";
+		if(!initOperator(RowsFileName))
+		{
+			cerr<<"Initialization Failed!..."<<endl;
+			cerr<<"Terminating..."<<endl<<endl;
+			if(mResultOfstream.is_open())
+				mResultOfstream<<"Search terminated...";
+			return 0;
+		}
+	}
+	else if(dictMode =="single")
 	{
 		cout<<"Reading a single dictionary : ";
 		if(!InitMatrixFromFile(mDict, DictFileName, mM, mN))
@@ -227,14 +266,30 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 	mExRec = new bool[mNoVectors];	
 	mErr = new float[mN];
 	mNMSE = new float[mNoVectors];
+	mLatency = new float[mNoVectors];
 	mNoExRecVec = 0;
 	mTime = 0;
+	mInitTime = 0;
+	mNoInitializations = 0;
+	mBatchTime = 0;
+	// correlations are precomputed in batches only with a single explicit dictionary
+	if(mMultiDict || mOperator)
+		mBatchSize = 0;
+	if(mBatchSize > 0)
+		mBatchCorr = allocateFloatMatrix(mBatchSize,mN);
 
 	cout<<endl<<"Initializing A*OMP..."<<endl;
 	mBaseOMP = new BaseOMP(mK,mM,mN,mEps,mInitPL);
-	mBaseOMP->setDict(mDict);
+	if(mOperator)
+		mBaseOMP->setOperator(mOperator);
+	else
+		mBaseOMP->setDict(mDict);
 	mBaseAStar = new BaseAStar(mB,mP,mI,mK,mN,mM,mAlpha, mBeta, mAuxiliaryFunctionMode);
 	mBaseAStar->getAlgorithmInterface()->setProblem(mBaseOMP);
+	mBaseAStar->setLazyExpansion(mLazyExpansion);
+	mBaseAStar->setMemoryBudget(mMemoryBudget);
+	if(mSearchMode == "beam")
+		mBeamSearch = new BeamSearch(mW,mB,mK,mBaseOMP);
 
 	if(mResultOfstream.is_open())
 	{
@@ -246,6 +301,15 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 		mResultOfstream<<myIntend<<"No Initial Branches (I):"<<mI<<"\r"<<endl;
 		mResultOfstream<<myIntend<<"No Branches per Extension (B): "<<mB<<"\r"<<endl;
 		mResultOfstream<<myIntend<<"No Maximum Paths in Stack (P): "<<mP<<"\r"<<endl;
+		mResultOfstream<<myIntend<<"Sensing Operator: "<<mOperatorType<<"\r"<<endl;
+		if(mBeamSearch)
+			mResultOfstream<<myIntend<<"Search Mode: Beam Search (W = "<<mW<<")"<<"\r"<<endl;
+		else
+			mResultOfstream<<myIntend<<"Search Mode: A* Search"<<"\r"<<endl;
+		mResultOfstream<<myIntend<<"Lazy Expansion: "<<(mLazyExpansion ? "on" : "off")<<"\r"<<endl;
+		mResultOfstream<<myIntend<<"OMP Fast Path: "<<(mOMPFastPath ? "on" : "off")<<"\r"<<endl;
+		mResultOfstream<<myIntend<<"Memory Budget: "<<mMemoryBudget<<" bytes"<<(mMemoryBudget ? "" : " (none)")<<"\r"<<endl;
+		mResultOfstream<<myIntend<<"Correlation Batch Size: "<<mBatchSize<<(mBatchSize ? "" : " (none)")<<"\r"<<endl;
 	}
 	cout<<myIntend<<"Max. Non-zero components (K): "<<mK<<endl;
 	cout<<myIntend<<"Error Tolerance for termination (Eps): "<<mEps<<endl;
@@ -254,6 +318,15 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 	cout<<myIntend<<"No Initial Branches (I):"<<mI<<endl;
 	cout<<myIntend<<"No Branches per Extension (B): "<<mB<<endl;
 	cout<<myIntend<<"No Maximum Paths in Stack (P): "<<mP<<endl;
+	cout<<myIntend<<"Sensing Operator: "<<mOperatorType<<endl;
+	if(mBeamSearch)
+		cout<<myIntend<<"Search Mode: Beam Search (W = "<<mW<<")"<<endl;
+	else
+		cout<<myIntend<<"Search Mode: A* Search"<<endl;
+	cout<<myIntend<<"Lazy Expansion: "<<(mLazyExpansion ? "on" : "off")<<endl;
+	cout<<myIntend<<"OMP Fast Path: "<<(mOMPFastPath ? "on" : "off")<<endl;
+	cout<<myIntend<<"Memory Budget: "<<mMemoryBudget<<" bytes"<<(mMemoryBudget ? "" : " (none)")<<endl;
+	cout<<myIntend<<"Correlation Batch Size: "<<mBatchSize<<(mBatchSize ? "" : " (none)")<<endl;
 	switch(mAuxiliaryFunctionMode)
 	{
 	case MUL :
@@ -316,6 +389,14 @@ int AStarOMPBuilder::init( std::string const pConfigFile )
 	mNoBranchAdded = 0;
 	mNoBranchIgnored = 0;
 	mNoBranchReplaced = 0;
+	mNoFullEvaluations = 0;
+	mNoEvaluationsAvoided = 0;
+	mNoOMPVectors = 0;
+	mNoPathsForgotten = 0;
+	mNoPathsRegenerated = 0;
+	mNoPathsDropped = 0;
+	mPeakMemory = 0;
+	mMaxPeakMemory = 0;
 
 	return 1;
 
@@ -343,18 +424,48 @@ int AStarOMPBuilder::run()
 		}
 
 		mBaseOMP->sety(mY[j]);
-		if(mBaseAStar->initialize())
+		if(mBatchCorr)
+		{
+			// correlations of the dictionary with the next mBatchSize observed vectors
+			if(!(j%mBatchSize))
+			{
+				clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time3);
+				computeInnerProdMatrix(mDict, mY+j, mBatchCorr, mN, min(mBatchSize,mNoVectors-j), mM);
+				clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time4);
+				mBatchTime = mBatchTime + diff(time3,time4).tv_sec + diff(time3,time4).tv_nsec/1000000000.0;
+				mTime = mTime + diff(time3,time4).tv_sec + diff(time3,time4).tv_nsec/1000000000.0;
+			}
+			mBaseOMP->setyCorrelations(mBatchCorr[j%mBatchSize]);
+		}
+		clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time1);
+		// fast path: the search is run only if OMP does not satisfy Eps
+		mSolvedByOMP = mOMPFastPath && mBaseOMP->runOMP();
+		bool initialized = mSolvedByOMP || mBeamSearch;
+		if(!initialized)
+		{
+			// initialization of A* search (priorities and initial paths) is timed separately as well
+			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time3);
+			initialized = (mBaseAStar->initialize() != 0);
+			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time4);
+			mInitTime = mInitTime + diff(time3,time4).tv_sec + diff(time3,time4).tv_nsec/1000000000.0;
+			mNoInitializations++;
+		}
+		if(initialized)
 		{
 			//cout<<"Running AStar Search..."<<endl<<endl;
 
-			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time1);
-			mBaseAStar->run();
+			if(mSolvedByOMP)
+				mNoOMPVectors++;
+			else if(mBeamSearch)
+				mBeamSearch->run();
+			else
+				mBaseAStar->run();
 			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time2);
-			mTime = mTime + diff(time1,time2).tv_nsec;
-			mTime = mTime/1000000000;
+			mLatency[j] = diff(time1,time2).tv_sec + diff(time1,time2).tv_nsec/1000000000.0;
+			mTime = mTime + mLatency[j];
 			
 			// write reconstructed vector to ofstream
-			float* mySol = (float*)mBaseAStar->getSolution();
+			float* mySol = mBaseOMP->getSolution();
 			if (mRecVectOfstream.is_open())
 			{
 				if(mBinOutput)
@@ -390,6 +501,9 @@ int AStarOMPBuilder::run()
 /// This function prints the reconstruction results after A*OMP is run.
 void AStarOMPBuilder::printEvaluation()
 {
+	// search statistics are averaged over the vectors that are not resolved by OMP on the fast path
+	float noSearched = (float)max(mNoVectors-mNoOMPVectors,1);
+
 	//Evaluation
 	// command line output
 	cout<<endl<<"RECONSTRUCTION RESULTS:"<<endl;
@@ -400,15 +514,48 @@ void AStarOMPBuilder::printEvaluation()
 		cout<<myIntend<<"No. Exactly Reconstructed Vectors: "<<mNoExRecVec<<endl;
 		cout<<myIntend<<"Exact Reconstruction Rate: %"<<(float)100*mNoExRecVec/mNoVectors<<endl;
 	}
-	cout<<myIntend<<"A* Search Analysis Results: "<<endl;
+	if(mBeamSearch)
+		cout<<myIntend<<"Beam Search Analysis Results: "<<endl;
+	else
+		cout<<myIntend<<"A* Search Analysis Results: "<<endl;
 	cout<<myIntend<<myIntend<<"Total Time: "<<mTime<<" sec."<<endl;
+	cout<<myIntend<<myIntend<<"Throughput: "<<mNoVectors/mTime<<" vectors/sec."<<endl;
+	if(mBatchCorr)
+		cout<<myIntend<<myIntend<<"Batch Correlation Time: "<<mBatchTime<<" sec."<<endl;
+	if(mOMPFastPath)
+		cout<<myIntend<<myIntend<<"Vectors Resolved by OMP: "<<mNoOMPVectors<<" (%"<<(float)100*mNoOMPVectors/mNoVectors<<")"<<endl;
 	cout<<myIntend<<myIntend<<"Statistics per vector:"<<endl;
 	cout<<myIntend<<myIntend<<myIntend<<"Average Time: "<<mTime/mNoVectors<<" sec."<<endl;
-	cout<<myIntend<<myIntend<<myIntend<<"No. Iterations: "<<(float)mNoIterations/mNoVectors<<endl;
-	cout<<myIntend<<myIntend<<myIntend<<"No. Added Branches: "<<(float)mNoBranchAdded/mNoVectors<<endl;
-	cout<<myIntend<<myIntend<<myIntend<<"No. Replaced Branches: "<<(float)mNoBranchReplaced/mNoVectors<<endl;
-	cout<<myIntend<<myIntend<<myIntend<<"No. Equivalent Branches: "<<(float)mNoEqBranch/mNoVectors<<endl;
-	cout<<myIntend<<myIntend<<myIntend<<"No. Ignored Branches: "<<(float)mNoBranchIgnored/mNoVectors<<endl<<endl;
+	cout<<myIntend<<myIntend<<myIntend<<"99th Percentile Time: "<<computePercentile(mLatency,mNoVectors,0.99)<<" sec."<<endl;
+	cout<<myIntend<<myIntend<<myIntend<<"Maximum Time: "<<computePercentile(mLatency,mNoVectors,1)<<" sec."<<endl;
+	if(mBeamSearch)
+	{
+		cout<<myIntend<<myIntend<<myIntend<<"No. Levels: "<<(float)mNoIterations/noSearched<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Evaluated Paths: "<<(float)mNoFullEvaluations/noSearched<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Equivalent Paths: "<<(float)mNoEqBranch/noSearched<<endl<<endl;
+	}
+	else
+	{
+		if(mNoInitializations)
+			cout<<myIntend<<myIntend<<myIntend<<"Average Initialization Time: "<<mInitTime/mNoInitializations<<" sec."<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Iterations: "<<(float)mNoIterations/noSearched<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Added Branches: "<<(float)mNoBranchAdded/noSearched<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Replaced Branches: "<<(float)mNoBranchReplaced/noSearched<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Equivalent Branches: "<<(float)mNoEqBranch/noSearched<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Ignored Branches: "<<(float)mNoBranchIgnored/noSearched<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Full Evaluations: "<<(float)mNoFullEvaluations/noSearched<<endl;
+		cout<<myIntend<<myIntend<<myIntend<<"No. Avoided Evaluations: "<<(float)mNoEvaluationsAvoided/noSearched<<endl;
+		if(mMemoryBudget)
+		{
+			cout<<myIntend<<myIntend<<myIntend<<"No. Forgotten Paths: "<<(float)mNoPathsForgotten/noSearched<<endl;
+			cout<<myIntend<<myIntend<<myIntend<<"No. Regenerated Paths: "<<(float)mNoPathsRegenerated/noSearched<<endl;
+			cout<<myIntend<<myIntend<<myIntend<<"No. Dropped Paths: "<<(float)mNoPathsDropped/noSearched<<endl;
+		}
+		cout<<myIntend<<myIntend<<myIntend<<"Peak Search Memory: "<<mPeakMemory/noSearched/1024<<" kB (max. "<<mMaxPeakMemory/1024.0<<" kB)"<<endl;
+		if(mMemoryBudget && mMaxPeakMemory > mMemoryBudget)
+			cout<<myIntend<<myIntend<<myIntend<<"Note: the memory budget was exceeded where the search stack and trie could not shrink further."<<endl;
+		cout<<endl;
+	}
 
 	// file output
 	if(mResultOfstream.is_open())
@@ -421,15 +568,47 @@ void AStarOMPBuilder::printEvaluation()
 			mResultOfstream<<myIntend<<"No. Exactly Reconstructed Vectors: "<<mNoExRecVec<<"\r"<<endl;
 			mResultOfstream<<myIntend<<"Exact Reconstruction Rate: %"<<(float)100*mNoExRecVec/mNoVectors<<"\r"<<endl;
 		}
-		mResultOfstream<<myIntend<<"A* Search Analysis Results: "<<"\r"<<endl;
+		if(mBeamSearch)
+			mResultOfstream<<myIntend<<"Beam Search Analysis Results: "<<"\r"<<endl;
+		else
+			mResultOfstream<<myIntend<<"A* Search Analysis Results: "<<"\r"<<endl;
 		mResultOfstream<<myIntend<<myIntend<<"Total Time: "<<mTime<<" sec."<<"\r"<<endl;
+		mResultOfstream<<myIntend<<myIntend<<"Throughput: "<<mNoVectors/mTime<<" vectors/sec."<<"\r"<<endl;
+		if(mBatchCorr)
+			mResultOfstream<<myIntend<<myIntend<<"Batch Correlation Time: "<<mBatchTime<<" sec."<<"\r"<<endl;
+		if(mOMPFastPath)
+			mResultOfstream<<myIntend<<myIntend<<"Vectors Resolved by OMP: "<<mNoOMPVectors<<" (%"<<(float)100*mNoOMPVectors/mNoVectors<<")"<<"\r"<<endl;
 		mResultOfstream<<myIntend<<myIntend<<"Statistics per vector:"<<"\r"<<endl;
 		mResultOfstream<<myIntend<<myIntend<<myIntend<<"Average Time: "<<mTime/mNoVectors<<" sec."<<"\r"<<endl;
-		mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Iterations: "<<(float)mNoIterations/mNoVectors<<"\r"<<endl;
-		mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Added Branches: "<<(float)mNoBranchAdded/mNoVectors<<"\r"<<endl;
-		mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Replaced Branches: "<<(float)mNoBranchReplaced/mNoVectors<<"\r"<<endl;
-		mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Equivalent Branches: "<<(float)mNoEqBranch/mNoVectors<<"\r"<<endl;
-		mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Ignored Branches: "<<(float)mNoBranchIgnored/mNoVectors<<"\r"<<endl;
+		mResultOfstream<<myIntend<<myIntend<<myIntend<<"99th Percentile Time: "<<computePercentile(mLatency,mNoVectors,0.99)<<" sec."<<"\r"<<endl;
+		mResultOfstream<<myIntend<<myIntend<<myIntend<<"Maximum Time: "<<computePercentile(mLatency,mNoVectors,1)<<" sec."<<"\r"<<endl;
+		if(mBeamSearch)
+		{
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Levels: "<<(float)mNoIterations/noSearched<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Evaluated Paths: "<<(float)mNoFullEvaluations/noSearched<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Equivalent Paths: "<<(float)mNoEqBranch/noSearched<<"\r"<<endl;
+		}
+		else
+		{
+			if(mNoInitializations)
+				mResultOfstream<<myIntend<<myIntend<<myIntend<<"Average Initialization Time: "<<mInitTime/mNoInitializations<<" sec."<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Iterations: "<<(float)mNoIterations/noSearched<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Added Branches: "<<(float)mNoBranchAdded/noSearched<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Replaced Branches: "<<(float)mNoBranchReplaced/noSearched<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Equivalent Branches: "<<(float)mNoEqBranch/noSearched<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Ignored Branches: "<<(float)mNoBranchIgnored/noSearched<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Full Evaluations: "<<(float)mNoFullEvaluations/noSearched<<"\r"<<endl;
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Avoided Evaluations: "<<(float)mNoEvaluationsAvoided/noSearched<<"\r"<<endl;
+			if(mMemoryBudget)
+			{
+				mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Forgotten Paths: "<<(float)mNoPathsForgotten/noSearched<<"\r"<<endl;
+				mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Regenerated Paths: "<<(float)mNoPathsRegenerated/noSearched<<"\r"<<endl;
+				mResultOfstream<<myIntend<<myIntend<<myIntend<<"No. Dropped Paths: "<<(float)mNoPathsDropped/noSearched<<"\r"<<endl;
+			}
+			mResultOfstream<<myIntend<<myIntend<<myIntend<<"Peak Search Memory: "<<mPeakMemory/noSearched/1024<<" kB (max. "<<mMaxPeakMemory/1024.0<<" kB)"<<"\r"<<endl;
+			if(mMemoryBudget && mMaxPeakMemory > mMemoryBudget)
+				mResultOfstream<<myIntend<<myIntend<<myIntend<<"Note: the memory budget was exceeded where the search stack and trie could not shrink further."<<"\r"<<endl;
+		}
 	}
 }
 
@@ -438,9 +617,7 @@ void AStarOMPBuilder::printEvaluation()
 /// @param VectorInd index of the test vector in the test vector matrix (mX).
 void AStarOMPBuilder::evaluateSingleVector( int VectorInd )
 {
-	float* mySol = (float*)mBaseAStar->getSolution();
-	SideInfo *mySideInfo = (SideInfo*)(mBaseAStar->getBestPath()->mSideInfo);
-	//float *res = mySideInfo->mRes;
+	float* mySol = mBaseOMP->getSolution();
 
 	// compute NMSE
 	subtractVectorfromVector(mX[VectorInd],mySol,mErr,mN);
@@ -454,7 +631,6 @@ void AStarOMPBuilder::evaluateSingleVector( int VectorInd )
 	if(mCompExactRec)
 	{
 		mExRec[VectorInd] = true;
-		vector<unsigned int> IndList = mySideInfo->mIndList;
 
 		for(int i = 0; i<mN; i++)
 		{
@@ -476,11 +652,29 @@ void AStarOMPBuilder::evaluateSingleVector( int VectorInd )
 			mNoExRecVec++;
 	}
 
+	if(mSolvedByOMP)
+		return;
+	if(mBeamSearch)
+	{
+		// levels, evaluated paths and equivalent paths of beam search
+		mNoIterations += mBeamSearch->getNoLevels();
+		mNoFullEvaluations += mBeamSearch->getNoEvaluations();
+		mNoEqBranch += mBeamSearch->getNoEqBranch();
+		return;
+	}
 	mNoIterations += mBaseAStar->getNoIterations();
 	mNoEqBranch += mBaseAStar->getNoEqBranch(); 
 	mNoBranchAdded += mBaseAStar->getNoBranchAdded();
 	mNoBranchIgnored += mBaseAStar->getNoBranchIgnored();
 	mNoBranchReplaced += mBaseAStar->getNoBranchReplaced();	
+	mNoFullEvaluations += mBaseAStar->getNoFullEvaluations();
+	mNoEvaluationsAvoided += mBaseAStar->getNoEvaluationsAvoided();
+	mNoPathsForgotten += mBaseAStar->getNoPathsForgotten();
+	mNoPathsRegenerated += mBaseAStar->getNoPathsRegenerated();
+	mNoPathsDropped += mBaseAStar->getNoPathsDropped();
+	mPeakMemory += mBaseAStar->getPeakMemory();
+	if(mBaseAStar->getPeakMemory() > mMaxPeakMemory)
+		mMaxPeakMemory = mBaseAStar->getPeakMemory();
 }
 
 AStarOMPBuilder::~AStarOMPBuilder()
@@ -495,12 +689,20 @@ AStarOMPBuilder::~AStarOMPBuilder()
 		delete mErr;
 	if(mNMSE)
 		delete mNMSE;
+	if(mLatency)
+		delete[] mLatency;
+	if(mBatchCorr)
+		deleteFloatMatrix(mBatchCorr,mBatchSize);
 	if(mExRec)
 		delete mExRec;
 	if(mBaseAStar)
 		delete mBaseAStar;
+	if(mBeamSearch)
+		delete mBeamSearch;
 	if(mBaseOMP)
 		delete mBaseOMP;
+	if(mOperator)
+		delete mOperator;
 	if (mRecVectOfstream.is_open())
 		mRecVectOfstream.close();
 
@@ -548,6 +750,54 @@ int AStarOMPBuilder::InitMatrixFromFile(float** pMatrix, string &pFileName, int
 		return 1;
 }
 
+// function to initialize the fast transform operator
+/// This function creates the operator selected by SensingOperator (hadamard or dct), which replaces
+/// the dictionary: the observation matrix consists of the M rows of the orthonormal N x N transform
+/// listed in pRowsFileName, a binary (.bin) or text (.txt) file of M row indices (0 based, increasing).
+/// N should be a power of 2.
+/// @param pRowsFileName name of the file from which the row indices are read
+/// @return 1 if the operator is initialized successfully, 0 if it fails.
+int AStarOMPBuilder::initOperator( string &pRowsFileName )
+{
+	if(mN < 2 || (mN & (mN-1)))
+	{
+		cerr<<"N should be a power of 2 for SensingOperator "<<mOperatorType<<endl;
+		return 0;
+	}
+	if(mOperatorType != "hadamard" && mOperatorType != "dct")
+	{
+		cerr<<"Invalid SensingOperator in config file. Should be matrix, hadamard or dct."<<endl;
+		return 0;
+	}
+	float** rowsFloat = allocateFloatMatrix(1,mM);
+	if(!InitMatrixFromFile(rowsFloat, pRowsFileName, mM, 1))
+	{
+		deleteFloatMatrix(rowsFloat,1);
+		return 0;
+	}
+	int* rows = new int[mM];
+	int valid = 1;
+	for(int i = 0; i<mM; i++)
+	{
+		rows[i] = (int)(rowsFloat[0][i]+0.5f);
+		if(rows[i] < 0 || rows[i] >= mN || (i > 0 && rows[i] <= rows[i-1]))
+			valid = 0;
+	}
+	deleteFloatMatrix(rowsFloat,1);
+	if(!valid)
+	{
+		cerr<<"Operator rows in "<<pRowsFileName<<" should be increasing and less than N"<<endl;
+		delete[] rows;
+		return 0;
+	}
+	if(mOperatorType == "hadamard")
+		mOperator = new HadamardOperator(mM,mN,rows);
+	else
+		mOperator = new DCTOperator(mM,mN,rows);
+	delete[] rows;
+	return 1;
+}
+
 // Function to get mTargetVectorsProvided
 /// @return mTargetVectorsProvided
 bool AStarOMPBuilder::getTargetVectorsProvided()
@@ -39,6 +39,18 @@ cost AlgorithmInterface::getPreCost( path* pPath, int pNewElementID )
 	return mProblem->computeCost((SideInfo*)pPath->mSideInfo, pNewElementID);
 }
 
+// Function interface for estimating pre-cost of pPath after expansion with pNewElementID without updating its SideInfo.
+/// This function should provide BaseAStar a cheap estimate of the pre-cost getPreCost would return, which is used to
+/// order paths in lazy expansion mode. The estimate should not be lower than the exact pre-cost. pPath and its side info
+/// must not be altered, since the side info is shared by all pending children of a path.
+/// @param pPath pointer to the path whose pre-score is to be estimated
+/// @param pNewElementID ID of the new element to be added to the path
+/// @return estimated pre-cost
+cost AlgorithmInterface::getPreCostEstimate( path* pPath, int pNewElementID )
+{
+	return mProblem->estimateCost((SideInfo*)pPath->mSideInfo, pNewElementID);
+}
+
 // Function interface for computing priorities of dictionary elements for sorting nodes in a path
 /// This function should provide BaseAStar class with the priorities of dictionary elements. These priorities should be stored 
 /// in pPriority, which is indexed by the order of elements in the dictionary. (i.e Dictionary element mDict[i] has priority pPriority[i].)
@@ -61,6 +73,23 @@ void* AlgorithmInterface::getNewSideInfo()
 	return  (void*)(mProblem->allocateSideInfo());
 }
 
+// Function interface to delete a SideInfo
+/// This function should delete a SideInfo structure allocated by getNewSideInfo.
+/// @param pSideInfo void* pointer to the SideInfo
+void AlgorithmInterface::deleteSideInfo( void* pSideInfo )
+{
+	mProblem->deleteSideInfo((SideInfo*)pSideInfo);
+}
+
+// Function interface to return the number of bytes allocated for a SideInfo
+/// This function should return the memory allocated for a SideInfo structure by getNewSideInfo. It is used by
+/// BaseAStar to account for the memory of the search.
+/// @return size of a SideInfo in bytes
+long AlgorithmInterface::getSideInfoSize()
+{
+	return mProblem->getSideInfoSize();
+}
+
 // Function interface to perform any necessary operations after A* search is terminated
 /// This function should perform the necessary operations on the solution after A* search is terminated. 
 /// It should extract the solution from pPath and store it in the problem class.
@@ -55,6 +55,9 @@ public:
 	/// Function interface for computing pre-cost of pPath after expansion with pNewElementID
 	cost getPreCost( path* pPath, int pNewElementID);
 
+	/// Function interface for estimating pre-cost of pPath after expansion with pNewElementID without updating its SideInfo
+	cost getPreCostEstimate( path* pPath, int pNewElementID);
+
 	/// Function interface for computing priorities of dictionary elements for sorting nodes in a path
 	void getPriorities(priority* pPriority);
 
@@ -64,6 +67,12 @@ public:
 	/// Function to allocate a new SideInfo
 	void* getNewSideInfo();
 
+	/// Function to delete a SideInfo
+	void deleteSideInfo(void* pSideInfo);
+
+	/// Function to return the number of bytes allocated for a SideInfo
+	long getSideInfoSize();
+
 	/// Function interface to perform any necessary operations to extract the solution after A* search is terminated
 	void performPostOperations(path *pPath);
 
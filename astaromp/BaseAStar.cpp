@@ -25,6 +25,16 @@ BaseAStar::BaseAStar(int pB, int pP, int pI, int pK, int pN, int pM,float pAlpha
 	mNoBranchAdded = 0;
 	mNoBranchReplaced = 0;
 	mNoIterations = 0;
+	mNoFullEvaluations = 0;
+	mNoEvaluationsAvoided = 0;
+	mLazyExpansion = false;
+	mMemoryBudget = 0;
+	mSideInfoSize = 0;
+	mNoSideInfos = 0;
+	mPeakMemory = 0;
+	mNoPathsForgotten = 0;
+	mNoPathsRegenerated = 0;
+	mNoPathsDropped = 0;
 	
 	mPriority = new priority[mN];
 	mSearchTrie.setPriority(mPriority);
@@ -57,15 +67,7 @@ BaseAStar::~BaseAStar(void)
 		delete mPriority;
 	if(mCandList)
 		delete mCandList;
-	if(mSearchStack.size())
-	{
-		searchStackIter myIter;	
-		for(myIter = mSearchStack.begin(); myIter!=mSearchStack.end(); myIter++)
-		{
-			if(myIter->second.mSideInfo)
-				delete myIter->second.mSideInfo;
-		}
-	}
+	clearSearchStack();
 
 	deletevector(mFreeSideInfoList);
 }
@@ -100,6 +102,20 @@ void BaseAStar::setAlpha( float pAlpha )
 		cout<<"Alpha should satisfy 0 < Alpha < 1 "<<endl;
 }
 
+// Function to set mLazyExpansion
+/// @param pLazyExpansion new value of mLazyExpansion
+void BaseAStar::setLazyExpansion( bool pLazyExpansion )
+{
+	mLazyExpansion = pLazyExpansion;
+}
+
+// Function to set mMemoryBudget
+/// @param pMemoryBudget new value of mMemoryBudget in bytes (0 for no budget)
+void BaseAStar::setMemoryBudget( long pMemoryBudget )
+{
+	mMemoryBudget = pMemoryBudget;
+}
+
 // Function to compute multiplicate cost function
 /// This function computes the multiplicative cost function for a path with path length pPathLenght and precost (i.e cost
 /// without any path length compensation) pPreCost.
@@ -158,6 +174,13 @@ int BaseAStar::initialize()
 	mNoBranchAdded = 0;
 	mNoBranchReplaced = 0;
 	mNoIterations = 0;
+	mNoFullEvaluations = 0;
+	mNoEvaluationsAvoided = 0;
+	mNoPathsForgotten = 0;
+	mNoPathsRegenerated = 0;
+	mNoPathsDropped = 0;
+	mPeakMemory = 0;
+	mSideInfoSize = mAlgInterface.getSideInfoSize();
 
 	//initialize the algorithm
 	vector<elementID *> nodeList;
@@ -190,6 +213,7 @@ int BaseAStar::initialize()
 			mAlgInterface.resetSideInfo(mTempPath.mSideInfo);
 			mTempPath.mPreCost = mAlgInterface.getInitialCost();
 			mTempPath.mLeaf = mSearchTrie.getRootNode();
+			mTempPath.mPending = false;
 			for(int j =0; j<nodesPerPath; j++)
 			{
 				tempNode = mSearchTrie.addPath(mTempPath.mLeaf, nodeList[i][j]);
@@ -202,6 +226,7 @@ int BaseAStar::initialize()
 			}
 			mSearchStack.insert(pair<cost, path>(tempCost,mTempPath));
 			mNoBranchAdded++;
+			enforceMemoryBudget();
 		}
 	}
 	else
@@ -219,6 +244,8 @@ int BaseAStar::initialize()
 /// This function runs a new search. Search is not run, and 0 is returned if search stack contains no initial paths.
 /// After the search terminates, AlgorithmInterface::performPostOperations is called for the search problem to extract 
 /// the solution from the SideInfo of the returned path. (This solution should be stored in the search problem class.)
+/// In lazy expansion mode, pending paths at the top of the stack are evaluated before the termination criterion is checked,
+/// and so are forgotten paths regenerated in memory-bounded mode.
 /// @return 0 if search is not performed as there are no initial paths in search stack, 1 otherwise
 int BaseAStar::run()
 {
@@ -228,10 +255,12 @@ int BaseAStar::run()
 		return 0;
 	}
 	//	while((int)(mSearchStack.begin()->second.mPathLength) < mK)
+		evaluateBestPath();
 		while (!mAlgInterface.isSearchComplete(&(mSearchStack.begin()->second)))
 		{
 			iterate();
 			mNoIterations++;	
+			evaluateBestPath();
 		}
 
 	//deletevector(mFreeSideInfoList);
@@ -266,17 +295,26 @@ int BaseAStar::iterate()
 		}
 	}
 
-	mFreeSideInfoList.push_back(mTempBestPath.mSideInfo);
+	releaseSideInfo(mTempBestPath.mSideInfo);
 	return 1;
 }
 // Function to add a new path to the search stack when the stack is not full
 /// This function adds a new path to the search stack if the stack is not full.
 /// The new path is passed to the function via class member mTempPath.
+/// In lazy expansion mode, the path is added with its estimated cost and shares the SideInfo of mTempBestPath.
 void BaseAStar::addPath()
 {
+	if(mLazyExpansion)
+	{
+		cost pathScore = EstimateCost(&mTempPath,mActualCand);
+		shareSideInfo(mTempPath.mSideInfo);
+		mSearchStack.insert(pair<cost,path>(pathScore,mTempPath));
+		return;
+	}
 	mTempPath.mSideInfo = getNewSideInfo();
 	mAlgInterface.copySideInfo(mTempBestPath.mSideInfo, mTempPath.mSideInfo);
 	mSearchStack.insert(pair<cost,path>(ComputeCost(&mTempPath,mActualCand),mTempPath));
+	mNoFullEvaluations++;
 }
 
 // Function to compute cost of a path
@@ -292,7 +330,7 @@ cost BaseAStar::ComputeCost(path* pPath, elementID pNewElementID )
 	{
 	case MUL :
 		{
-			pPath->mPreCost = mAlgInterface.getPreCost(&mTempPath,pNewElementID);
+			pPath->mPreCost = mAlgInterface.getPreCost(pPath,pNewElementID);
 			return compansatePathLengthMult(pPath->mPreCost, pPath->mPathLength);	
 			break;
 		}
@@ -322,14 +360,229 @@ cost BaseAStar::ComputeCost(path* pPath, elementID pNewElementID )
 	return -1;
 }
 
+// Function to estimate cost of a path and mark it as pending
+/// This function computes the cost of pPath with the selected cost model mAuxiliaryFunctionMode as ComputeCost does,
+/// but from the pre-cost estimate of the search problem, which does not update the SideInfo. pPath is marked as pending
+/// with its last node pNewElementID; its SideInfo and precost remain those of the parent path until evaluateBestPath.
+/// The estimate is not lower than the exact pre-cost, and all cost models increase with the pre-cost, so a pending path
+/// never gets a lower cost than it would get from ComputeCost.
+/// @param pPath pointer to the path whose cost is inquired
+/// @param pNewElementID elementID of the last node added to pPath
+/// @return estimated cost of pPath
+cost BaseAStar::EstimateCost( path* pPath, elementID pNewElementID )
+{
+	cost preCost = mAlgInterface.getPreCostEstimate(pPath,pNewElementID);
+	pPath->mPending = true;
+	pPath->mPendingID = pNewElementID;
+	mNoEvaluationsAvoided++;
+	switch(mAuxiliaryFunctionMode)
+	{
+	case MUL :
+		return compansatePathLengthMult(preCost, pPath->mPathLength);
+	case ADAP :
+		return compansatePathLengthAdap(preCost, pPath->mPreCost, pPath->mPathLength);
+	case ADAPMUL :
+		return compansatePathLengthAdapMul(preCost, pPath->mPreCost, pPath->mPathLength);
+	default:
+		cerr<<"Invalid AuxiliaryFunctionMode in BaseAStar::EstimateCost()"<<endl;
+		return -1;
+	}
+}
+
+// Function to evaluate the pending paths at the top of the search stack
+/// This function evaluates the best path in the search stack if it is pending (lazy expansion) or forgotten (memory-bounded
+/// mode). A forgotten path is regenerated first. A pending path gets its own SideInfo, copied from the one it shares with
+/// its siblings (or taken over if no other path uses it), and its exact cost is computed via ComputeCost. The path is inserted
+/// back at the top of the stack. This is repeated until the best path is neither pending nor forgotten, so that the best path
+/// is always evaluated before it is checked for termination or expanded.
+void BaseAStar::evaluateBestPath()
+{
+	while(mSearchStack.begin()->second.mPending || !mSearchStack.begin()->second.mSideInfo)
+	{
+		cost pathScore = mSearchStack.begin()->first;
+		mTempPath = mSearchStack.begin()->second;
+		mSearchStack.erase(mSearchStack.begin());
+		if(!mTempPath.mSideInfo)
+			regeneratePath(&mTempPath);
+		else if(mSideInfoRefs.count(mTempPath.mSideInfo))
+		{
+			void* sharedSideInfo = mTempPath.mSideInfo;
+			mTempPath.mSideInfo = getNewSideInfo();
+			mAlgInterface.copySideInfo(sharedSideInfo, mTempPath.mSideInfo);
+			releaseSideInfo(sharedSideInfo);
+		}
+		if(mTempPath.mPending)
+		{
+			mTempPath.mPending = false;
+			pathScore = ComputeCost(&mTempPath,mTempPath.mPendingID);
+			mNoFullEvaluations++;
+			mNoEvaluationsAvoided--;
+		}
+		mSearchStack.insert(mSearchStack.begin(),pair<cost,path>(pathScore,mTempPath));
+		enforceMemoryBudget();
+	}
+}
+
+// Function to regenerate the SideInfo of a forgotten path
+/// This function allocates a new SideInfo for the forgotten path pPath and recomputes it by adding the nodes of the path,
+/// which are read from the trie, one by one as in initialize. The last node of a pending path is not added, so that the
+/// SideInfo is that of its parent. The nodes are added in the order of the trie (descending priority), which gives the
+/// same residue and pre-cost as the order in which the path was found.
+/// @param pPath pointer to the forgotten path
+void BaseAStar::regeneratePath( path* pPath )
+{
+	vector<elementID> nodeList;
+	for(TrieNode* node = pPath->mLeaf; !node->isRoot(); node = node->getParent())
+	{
+		if(!pPath->mPending || node->getElementID() != pPath->mPendingID)
+			nodeList.push_back(node->getElementID());
+	}
+	pPath->mSideInfo = getNewSideInfo();
+	mAlgInterface.resetSideInfo(pPath->mSideInfo);
+	cost preCost = mAlgInterface.getInitialCost();
+	while(nodeList.size()>0)
+	{
+		preCost = mAlgInterface.getPreCost(pPath, nodeList.back());
+		nodeList.pop_back();
+	}
+	if(!pPath->mPending)
+		pPath->mPreCost = preCost;
+	mNoPathsRegenerated++;
+}
+
+// Function to compute the memory used by the search
+/// This function returns the memory of the search in bytes: the allocated SideInfos (in use or free), the nodes of the trie
+/// and the entries of the search stack.
+/// @return memory of the search in bytes
+long BaseAStar::computeMemory()
+{
+	return mNoSideInfos*mSideInfoSize + mSearchTrie.getNoNodes()*Trie::getNodeSize()
+		+ (long)mSearchStack.size()*((long)sizeof(pair<cost,path>) + 4*(long)sizeof(void*));
+}
+
+// Function to keep the memory of the search within mMemoryBudget
+/// This function is called after paths are added to the search stack and the trie. If mMemoryBudget is set and exceeded,
+/// it deletes the free SideInfos, forgets the worst paths in the search stack, drops the worst paths, and as a last resort
+/// prunes the trie until the memory is within the budget or nothing is left to remove. mPeakMemory is updated afterwards.
+/// New SideInfos are not allocated beyond the budget in the first place (getNewSideInfo). The budget is best effort: once
+/// the stack holds only the best path and the trie only the paths in process, the memory (and mPeakMemory) may exceed it.
+void BaseAStar::enforceMemoryBudget()
+{
+	long memory = computeMemory();
+	while(mMemoryBudget > 0 && memory > mMemoryBudget)
+	{
+		if((int)mFreeSideInfoList.size()>0)
+		{
+			mAlgInterface.deleteSideInfo(mFreeSideInfoList.back());
+			mFreeSideInfoList.pop_back();
+			mNoSideInfos--;
+		}
+		else if(!forgetWorstPath() && !dropWorstPath() && !pruneSearchTrie())
+			break;
+		memory = computeMemory();
+	}
+	if(memory > mPeakMemory)
+		mPeakMemory = memory;
+}
+
+// Function to forget the worst path in the search stack that has a SideInfo
+/// This function frees the SideInfo of the worst path in the search stack (except the best path) that has one. The path
+/// stays in the stack with its cost, so that it is regenerated by evaluateBestPath if it reaches the top. The SideInfo of
+/// a pending path is shared, and it is freed only with the last path that uses it.
+/// @return true if a path is forgotten, false if all paths except the best path are already forgotten
+bool BaseAStar::forgetWorstPath()
+{
+	searchStackIter myIter = mSearchStack.end();
+	while(myIter != mSearchStack.begin())
+	{
+		myIter--;
+		if(myIter == mSearchStack.begin())
+			break;
+		if(myIter->second.mSideInfo)
+		{
+			releaseSideInfo(myIter->second.mSideInfo);
+			myIter->second.mSideInfo = NULL;
+			mNoPathsForgotten++;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Function to remove the nodes of the paths that are not in the search stack from the trie
+/// This function removes the nodes of expanded and pruned paths from the trie, which are kept only to avoid equivalent
+/// paths, and may then be explored again. The paths in the search stack are kept, as well as mTempBestPath and mTempPath,
+/// which may be in process out of the stack when this function is called.
+/// @return true if any nodes are removed
+bool BaseAStar::pruneSearchTrie()
+{
+	set<TrieNode*> leafNodes;
+	for(searchStackIter myIter = mSearchStack.begin(); myIter != mSearchStack.end(); myIter++)
+		leafNodes.insert(myIter->second.mLeaf);
+	leafNodes.insert(mTempBestPath.mLeaf);
+	leafNodes.insert(mTempPath.mLeaf);
+	return mSearchTrie.pruneTrie(&leafNodes) > 0;
+}
+
+// Function to drop the worst path from the search stack and the trie
+/// This function removes the worst path from the search stack and its nodes from the trie, unless it is the only path in
+/// the stack. As the path is no longer in the trie, it may be added again by the expansion of another path.
+/// @return true if a path is dropped, false otherwise
+bool BaseAStar::dropWorstPath()
+{
+	if((int)mSearchStack.size() <= 1)
+		return false;
+	searchStackIter myIter = mSearchStack.end();
+	myIter--;
+	releaseSideInfo(myIter->second.mSideInfo);
+	mSearchTrie.removePath(myIter->second.mLeaf);
+	mSearchStack.erase(myIter);
+	mNoPathsDropped++;
+	return true;
+}
+
+// Function to add a reference to a SideInfo shared by pending paths
+/// This function counts a new path that uses pSideInfo. SideInfos that are used by a single path are not stored in
+/// mSideInfoRefs.
+/// @param pSideInfo pointer to the SideInfo
+void BaseAStar::shareSideInfo( void* pSideInfo )
+{
+	map<void*,int>::iterator myIter = mSideInfoRefs.find(pSideInfo);
+	if(myIter == mSideInfoRefs.end())
+		mSideInfoRefs.insert(pair<void*,int>(pSideInfo,2));
+	else
+		myIter->second++;
+}
+
+// Function to remove a reference to a SideInfo and free it if it is not used anymore
+/// This function is called when a path that uses pSideInfo is removed from the search stack. pSideInfo is moved to
+/// mFreeSideInfoList if no other path uses it. Forgotten paths have no SideInfo (pSideInfo is NULL).
+/// @param pSideInfo pointer to the SideInfo
+void BaseAStar::releaseSideInfo( void* pSideInfo )
+{
+	if(!pSideInfo)
+		return;
+	map<void*,int>::iterator myIter = mSideInfoRefs.find(pSideInfo);
+	if(myIter == mSideInfoRefs.end())
+		mFreeSideInfoList.push_back(pSideInfo);	//we will use this space later (avoid reallocation)
+	else if(--(myIter->second) == 1)
+		mSideInfoRefs.erase(myIter);
+}
+
 // Function to get a new SideInfo
 /// This function returns a pointer to a SideInfo instance that can be assigned to a new path in the search stack.
 /// If there is a free SideInfo in mFreeSideInfoList, a pointer to it is returned. Otherwise, a new SideInfo is created
 /// via AlgorithmInterface by the search problem and a pointer to it is returned. (The contents of the returned SideInfo
-/// are not cleared.)
+/// are not cleared.) If mMemoryBudget is set, room for the new SideInfo is made before it is allocated: the worst paths
+/// in the search stack are forgotten or dropped (and the trie is pruned) until a SideInfo is freed or a new one fits into the budget.
 /// @return pointer to the new SideInfo struct
 void* BaseAStar::getNewSideInfo()
 {
+	while((int)mFreeSideInfoList.size()==0 && mMemoryBudget > 0 && computeMemory()+mSideInfoSize > mMemoryBudget)
+	{
+		if(!forgetWorstPath() && !dropWorstPath() && !pruneSearchTrie())
+			break;
+	}
 	if((int)mFreeSideInfoList.size()>0)
 	{
 		void *mySideInfo;
@@ -339,7 +592,10 @@ void* BaseAStar::getNewSideInfo()
 	}
 	else
 	{
-		return mAlgInterface.getNewSideInfo();	//new residue
+		mNoSideInfos++;
+		void *mySideInfo = mAlgInterface.getNewSideInfo();	//new residue
+		enforceMemoryBudget();
+		return mySideInfo;
 	}
 }
 
@@ -347,23 +603,34 @@ void* BaseAStar::getNewSideInfo()
 /// This function adds a new path to the search stack if the stack is full (i.e. has mP paths).
 /// The new path is passed to the function via class member mTempPath. This path is added to the search stack iff 
 /// its cost is lower than the worst path in the tree, which forces removal of the worst path from the stack.
+/// In lazy expansion mode, the path is compared with its estimated cost and needs no SideInfo of its own.
 void BaseAStar::addPath_StackFull()
 {
-	mTempPath.mSideInfo = getNewSideInfo();
-	mAlgInterface.copySideInfo(mTempBestPath.mSideInfo, mTempPath.mSideInfo);
-	cost pathScore = ComputeCost(&mTempPath,mActualCand);
+	cost pathScore;
+	if(mLazyExpansion)
+		pathScore = EstimateCost(&mTempPath,mActualCand);
+	else
+	{
+		mTempPath.mSideInfo = getNewSideInfo();
+		mAlgInterface.copySideInfo(mTempBestPath.mSideInfo, mTempPath.mSideInfo);
+		pathScore = ComputeCost(&mTempPath,mActualCand);
+		mNoFullEvaluations++;
+	}
 	searchStackIter myIter = mSearchStack.end();
 	myIter--;
 	if(myIter->first >= pathScore)
 	{	//if we are here, residue was surely used... otherwise, there cannot be mP paths.
-		mFreeSideInfoList.push_back(myIter->second.mSideInfo);	//we will use this space later (avoid reallocation)
+		if(mLazyExpansion)
+			shareSideInfo(mTempPath.mSideInfo);
+		releaseSideInfo(myIter->second.mSideInfo);
 		mSearchStack.erase(myIter);
 		mSearchStack.insert(pair<cost,path>(pathScore,mTempPath));
 		mNoBranchAdded++;
 	}
 	else
 	{
-		mFreeSideInfoList.push_back(mTempPath.mSideInfo);
+		if(!mLazyExpansion)
+			mFreeSideInfoList.push_back(mTempPath.mSideInfo);
 		mNoBranchIgnored++;
 	}
 }
@@ -398,6 +665,7 @@ void BaseAStar::processBranch(int pBranchNo)
 			addPath_StackFull();
 		}
 	}
+	enforceMemoryBudget();
 }
 
 // Function to get mAlgorithmInterface
@@ -438,6 +706,42 @@ int BaseAStar::getNoIterations()
 {
 	return mNoIterations;
 }
+// Function to get mNoFullEvaluations
+/// @return mNoFullEvaluations
+int BaseAStar::getNoFullEvaluations()
+{
+	return mNoFullEvaluations;
+}
+// Function to get mNoEvaluationsAvoided
+/// @return mNoEvaluationsAvoided
+int BaseAStar::getNoEvaluationsAvoided()
+{
+	return mNoEvaluationsAvoided;
+}
+// Function to get mNoPathsForgotten
+/// @return mNoPathsForgotten
+int BaseAStar::getNoPathsForgotten()
+{
+	return mNoPathsForgotten;
+}
+// Function to get mNoPathsRegenerated
+/// @return mNoPathsRegenerated
+int BaseAStar::getNoPathsRegenerated()
+{
+	return mNoPathsRegenerated;
+}
+// Function to get mNoPathsDropped
+/// @return mNoPathsDropped
+int BaseAStar::getNoPathsDropped()
+{
+	return mNoPathsDropped;
+}
+// Function to get mPeakMemory
+/// @return mPeakMemory in bytes
+long BaseAStar::getPeakMemory()
+{
+	return mPeakMemory;
+}
 
 // Function to get the best path in search stack
 /// This function returns the best path in the search stack. As paths in mSearchStack are ordered wrt. ascending cost,
@@ -456,7 +760,7 @@ void BaseAStar::clearSearchStack()
 	for(myIter = mSearchStack.begin(); myIter!= mSearchStack.end(); myIter++)
 	{		
 		//delete myIter->second.mSideInfo;
-		mFreeSideInfoList.push_back( myIter->second.mSideInfo);
+		releaseSideInfo( myIter->second.mSideInfo);
 	}
 	mSearchStack.clear();
 }
@@ -39,6 +39,16 @@ karahanoglu@sabanciuniv.edu,  burak.karahanoglu@gmail.com
 /// its SideInfo is not deleted, but stored in the vector mFreeSideInfoList for later use. A nes SideInfo is allocated only when 
 /// mFreeSideInfoList contains no free SideInfo.
 ///
+/// In lazy expansion mode, the children of an expanded path enter the search stack with an estimated cost and share the
+/// SideInfo of their parent, which is reference counted in mSideInfoRefs. The exact cost and a SideInfo of their own are
+/// computed only when a child reaches the top of the stack, so children that are pruned or never selected are not evaluated.
+///
+/// In memory-bounded mode, the memory of the search (SideInfos, trie nodes and stack entries) is kept within mMemoryBudget
+/// bytes. When it is exceeded, the worst paths in the stack are forgotten: their SideInfos are freed, but they stay in the stack
+/// with their costs and are regenerated from the trie if they reach the top. If this is not enough, the worst paths are
+/// dropped from the stack and removed from the trie, so that they can be found again by a later expansion. As a last resort,
+/// the trie is pruned to the paths in the stack. Once nothing is left to remove, the memory may still exceed the budget.
+///
 /// Note that this class calls no functions from the problem class directly, but runs these via
 /// the AlgorithmInterface class . This provides flexibilty to change the search problem 
 /// only by modifying the function calls in the AlgorithmInterface, without the necessity of modifying this BaseAStar implementation.
@@ -76,6 +86,12 @@ public:
 	/// Function to set mAlpha
 	void setAlpha(float pAlpha);
 
+	/// Function to set mLazyExpansion
+	void setLazyExpansion(bool pLazyExpansion);
+
+	/// Function to set mMemoryBudget
+	void setMemoryBudget(long pMemoryBudget);
+
 	/// Function to set mPriority
 	void setPriority(float* pPriority);
 
@@ -96,6 +112,18 @@ public:
 	int getNoBranchReplaced();
 	/// Function to get mNoIterations
 	int getNoIterations();
+	/// Function to get mNoFullEvaluations
+	int getNoFullEvaluations();
+	/// Function to get mNoEvaluationsAvoided
+	int getNoEvaluationsAvoided();
+	/// Function to get mNoPathsForgotten
+	int getNoPathsForgotten();
+	/// Function to get mNoPathsRegenerated
+	int getNoPathsRegenerated();
+	/// Function to get mNoPathsDropped
+	int getNoPathsDropped();
+	/// Function to get mPeakMemory
+	long getPeakMemory();
 
 	/// Function to get the best path in search stack
 	path* getBestPath();
@@ -135,6 +163,36 @@ private:
 	/// Function to compute cost of a path
 	cost ComputeCost(path* pPath, elementID pNewElementID);
 
+	/// Function to estimate cost of a path and mark it as pending
+	cost EstimateCost(path* pPath, elementID pNewElementID);
+
+	/// Function to evaluate the pending paths at the top of the search stack
+	void evaluateBestPath();
+
+	/// Function to add a reference to a SideInfo shared by pending paths
+	void shareSideInfo(void* pSideInfo);
+
+	/// Function to remove a reference to a SideInfo and free it if it is not used anymore
+	void releaseSideInfo(void* pSideInfo);
+
+	/// Function to compute the memory used by the search
+	long computeMemory();
+
+	/// Function to keep the memory of the search within mMemoryBudget
+	void enforceMemoryBudget();
+
+	/// Function to forget the worst path in the search stack that has a SideInfo
+	bool forgetWorstPath();
+
+	/// Function to remove the nodes of the paths that are not in the search stack from the trie
+	bool pruneSearchTrie();
+
+	/// Function to drop the worst path from the search stack and the trie
+	bool dropWorstPath();
+
+	/// Function to regenerate the SideInfo of a forgotten path
+	void regeneratePath(path* pPath);
+
 	Trie mSearchTrie;			///< Search tree
 	searchStack mSearchStack;	///< Search stack
 	int mB;				///< Number of extensions per path
@@ -154,6 +212,17 @@ private:
 	int mNoBranchAdded;		///< Number of branches added to the stack during the search
 	int mNoBranchIgnored;	///< Number of branches ignored during the search
 	int mNoBranchReplaced;	///< Number of branches replaced during the search
+	int mNoFullEvaluations;	///< Number of exact cost evaluations of expanded branches during the search
+	int mNoEvaluationsAvoided;	///< Number of branches whose evaluation is deferred and not performed (lazy expansion)
+	bool mLazyExpansion;	///< true for lazy expansion: children are evaluated when they reach the top of the stack
+	map<void*,int> mSideInfoRefs;	///< Number of paths sharing a SideInfo, for SideInfos with more than one path
+	long mMemoryBudget;		///< Memory budget of the search in bytes (0 for no budget)
+	long mSideInfoSize;		///< Size of a SideInfo in bytes
+	int mNoSideInfos;		///< Number of allocated SideInfos (in use or in mFreeSideInfoList)
+	long mPeakMemory;		///< Peak memory of the search in bytes
+	int mNoPathsForgotten;	///< Number of paths whose SideInfo is freed (memory-bounded mode)
+	int mNoPathsRegenerated;	///< Number of forgotten paths that are regenerated (memory-bounded mode)
+	int mNoPathsDropped;	///< Number of paths dropped from the stack and the trie (memory-bounded mode)
 	//temporary for run...
 	elementID* mCandList;	///< Temporary storage for best candidates
 	path mTempBestPath;		///< Temporary storage for best path
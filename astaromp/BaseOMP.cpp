@@ -16,6 +16,14 @@ BaseOMP::BaseOMP( int pK,int pM,int pN, float pEps, int pNodesPerInitPath )
 	mEps = pEps;
 	mSolution = new float[mN];
 	mDictNorm = new float[mN];
+	mDict = NULL;
+	mOperator = NULL;
+	mCorr = new float[mN];
+	mCorrOrder = new unsigned int[mN];
+	mCorrOrderValid = false;
+	myCorr = NULL;
+	mAtom = new float[mM];
+	mOMPSideInfo = NULL;
 }
 
 // Destructor
@@ -24,6 +32,11 @@ BaseOMP::~BaseOMP(void)
 {
 	delete mSolution;
 	delete mDictNorm;
+	delete[] mCorr;
+	delete[] mCorrOrder;
+	delete[] mAtom;
+	if(mOMPSideInfo)
+		deleteSideInfo(mOMPSideInfo);
 }
 
 // Function to solve for the sparse target vector from the QR decomposition.
@@ -82,15 +95,95 @@ void BaseOMP::addElementToRepresentation( float* pNewElement, int i, float** pQ,
 void BaseOMP::setDict( float** pDict )
 {
 	mDict = pDict;
+	mOperator = NULL;
+	mCorrOrderValid = false;
 	for(int i = 0; i<mN; i++)
 		mDictNorm[i] = l2Norm(mDict[i],mM);
 }
 
+// Function to set mOperator
+/// This function sets mOperator, which is used instead of an explicit dictionary: correlations with
+/// all atoms are computed by a product with the transpose of the operator, and only the atoms that
+/// are added to a path are generated. Norms of the columns are stored in mDictNorm.
+/// The operator is not owned by BaseOMP.
+/// @param pOperator pointer to the operator (M x N)
+void BaseOMP::setOperator( LinearOperator* pOperator )
+{
+	mOperator = pOperator;
+	mDict = NULL;
+	mOperator->computeColumnNorms(mDictNorm);
+	mCorrOrderValid = false;
+}
+
+// Function to return a dictionary atom
+/// This function returns the pID'th dictionary atom. If mOperator is set, the atom is generated
+/// into mAtom, which is overwritten by the next call.
+/// @param pID index of the atom
+/// @return pointer to the atom (vector of size M)
+float* BaseOMP::getAtom( int pID )
+{
+	if(!mOperator)
+		return mDict[pID];
+	mOperator->getColumn(pID,mAtom);
+	return mAtom;
+}
+
+// Function to compute correlations of all dictionary atoms with a vector via mOperator
+/// This function computes the absolute inner products of pVector with all atoms, divided by the
+/// norms of the atoms, by one product with the transpose of mOperator. They are stored in mCorr.
+/// @param pVector pointer to the vector of size M
+void BaseOMP::computeCorrelations( float* pVector )
+{
+	mOperator->applyTranspose(pVector,mCorr);
+	for(int i=0; i<mN;i++)
+		mCorr[i] = abs(mCorr[i])/mDictNorm[i];
+}
+
+// Function to find a sorted list of dictionary atoms which lie closest to a vector
+/// This function returns the indices of pReturnSize atoms having maximum normalized correlation
+/// with pVector, from mDict or mOperator, in a map that is sorted wrt. decreasing correlation.
+/// @param pVector pointer to the vector
+/// @param pReturnSize number of atoms to be returned
+/// @return map that stores indices of atoms having maximum correlation with pVector.
+map<float,int,greater<float> >* BaseOMP::findClosestAtoms( float* pVector, int pReturnSize )
+{
+	if(!mOperator)
+		return findClosestVectorsIndList( mDict, mDictNorm, pVector, mN, pReturnSize, mM);
+
+	computeCorrelations(pVector);
+	map<float,int,greater<float> >* tempCost = new map<float,int,greater<float> >;
+	map<float,int,greater<float> >::iterator tempCostIter;
+	for(int i=0; i<mN;i++)
+	{
+		tempCost->insert(pair<float,int>(mCorr[i],i));
+		if((int)tempCost->size() > pReturnSize)
+		{
+			tempCostIter = tempCost->end();
+			tempCostIter--;
+			tempCost->erase(tempCostIter);
+		}
+	}
+	return tempCost;
+}
+
 // Function to set y
 void BaseOMP::sety( float* py )
 {
 	my = py;
 	mNorm_y = l2Norm(my,mM);
+	myCorr = NULL;
+	mCorrOrderValid = false;
+}
+
+// Function to set the precomputed inner products of the dictionary atoms with y
+/// This function sets myCorr, the inner products of all atoms with my (not normalized), which are then used by
+/// computeInitialCorrelations instead of N inner products. It should be called after sety, which resets it.
+/// The vector is not owned by BaseOMP.
+/// @param pyCorr pointer to the vector of inner products (of size N)
+void BaseOMP::setyCorrelations( float* pyCorr )
+{
+	myCorr = pyCorr;
+	mCorrOrderValid = false;
 }
 
 // Function to initialize paths for A*OMP
@@ -129,18 +222,17 @@ int BaseOMP::findInitialPaths1( int pNoInitialPaths, vector<unsigned int*> *pNod
 		return 0;
 	}
 
-	//find best candidates
-	map<float,int,greater<float> >* tempCost = findClosestVectorsIndList( mDict, mDictNorm, my, mN, pNoInitialPaths, mM);
+	//best candidates are the first atoms in mCorrOrder (computed once with the priorities)
+	if(!mCorrOrderValid)
+		computeInitialCorrelations();
 
 	//initialize pNodeList
-	map<float,int,greater<float> >::iterator myIter = tempCost->begin();
-	for(int i = 0;i<pNoInitialPaths;i++,myIter++ )
+	for(int i = 0;i<pNoInitialPaths;i++ )
 	{
 		unsigned int* myInt = new unsigned int;
-		*myInt = myIter->second;
+		*myInt = mCorrOrder[i];
 		pNodeList->push_back(myInt);
 	}
-	delete tempCost;
 	return 1;
 }
 
@@ -162,12 +254,13 @@ int BaseOMP::findInitialPaths2( int pNoInitialPaths, vector<unsigned int*> *pNod
 	}
 
 	// add DC component
-	float DCCorr = computeInnerProd(mDict[0], my, mM)/mDictNorm[0];
+	float* DCAtom = getAtom(0);
+	float DCCorr = computeInnerProd(DCAtom, my, mM)/mDictNorm[0];
 	float *res = new float[mM];
-	subtractProductScalarfromVector(my,mDict[0],res,DCCorr/mDictNorm[0],mM);
+	subtractProductScalarfromVector(my,DCAtom,res,DCCorr/mDictNorm[0],mM);
 
 	//find best candidates
-	map<float,int,greater<float> >* tempCost = findClosestVectorsIndList( mDict, mDictNorm, res, mN, pNoInitialPaths, mM);
+	map<float,int,greater<float> >* tempCost = findClosestAtoms( res, pNoInitialPaths );
 	
 	//initialize pNodeList
 	map<float,int,greater<float> >::iterator myIter = tempCost->begin();
@@ -185,12 +278,75 @@ int BaseOMP::findInitialPaths2( int pNoInitialPaths, vector<unsigned int*> *pNod
 // Function to find the best candidates for expansion of a path
 /// This function finds and returns the pNoCand best candidates in the dictionary for the expansion of the path in pSideInfo.
 /// Candidates are selected wrt. their correlations to the residue in pSideInfo and are returned in pCandList.
+/// For an empty path, whose residue is y, they are read from mCorrOrder (computeInitialCorrelations).
 /// @param pNoCand number of requested candidates
 /// @param pSideInfo pointer to the SideInfo struct containing info about the path to be expanded
 /// @param pCandList pointer to the list of selected dictionary atoms
 void BaseOMP::findBestCandidates( int pNoCand, SideInfo* pSideInfo, elementID* pCandList )
 {
-	findClosestVectorsIndList( mDict, mDictNorm, pSideInfo->mRes, pCandList, mN, pNoCand, mM );
+	if(pSideInfo->mIndList.empty())
+	{
+		// the residue of an empty path is my
+		if(!mCorrOrderValid)
+			computeInitialCorrelations();
+		for(int i = 0; i<pNoCand; i++)
+			pCandList[i] = mCorrOrder[i];
+		return;
+	}
+	if(!mOperator)
+	{
+		findClosestVectorsIndList( mDict, mDictNorm, pSideInfo->mRes, pCandList, mN, pNoCand, mM );
+		return;
+	}
+	map<float,int,greater<float> >* tempCost = findClosestAtoms( pSideInfo->mRes, pNoCand );
+	map<float,int,greater<float> >::iterator tempCostIter = tempCost->begin();
+	for(int i = 0; i<pNoCand; i++, tempCostIter++)
+		pCandList[i] = tempCostIter->second;
+	delete tempCost;
+}
+
+// Function to find the best candidates for expansion of a set of paths
+/// This function finds the pNoCand best candidates for each of the pNoPaths paths in pSideInfos, as findBestCandidates does,
+/// and returns them in pCandList (pNoCand per path, in the order of the paths). With mDict, the correlations are computed
+/// in a single pass over the dictionary, in which each atom is correlated with the residues of all paths; with mOperator,
+/// one product with the transpose is needed per path. A single empty path is left to findBestCandidates.
+/// @param pNoCand number of requested candidates per path
+/// @param pSideInfos pointer to the array of SideInfos of the paths
+/// @param pNoPaths number of paths
+/// @param pCandList pointer to the list of selected dictionary atoms (pNoCand x pNoPaths)
+void BaseOMP::findBestCandidatesBatch( int pNoCand, SideInfo** pSideInfos, int pNoPaths, elementID* pCandList )
+{
+	if(mOperator || (pNoPaths == 1 && pSideInfos[0]->mIndList.empty()))
+	{
+		for(int p = 0; p<pNoPaths; p++)
+			findBestCandidates(pNoCand, pSideInfos[p], pCandList+p*pNoCand);
+		return;
+	}
+	vector<map<float,int,greater<float> > > tempCost(pNoPaths);
+	map<float,int,greater<float> >::iterator tempCostIter;
+	float tempCorr;
+	for(int i=0; i<mN; i++)
+	{
+		for(int p = 0; p<pNoPaths; p++)
+		{
+			tempCorr = abs(computeInnerProd(mDict[i],pSideInfos[p]->mRes,mM))/mDictNorm[i];
+			if((int)tempCost[p].size() == pNoCand && tempCorr <= tempCost[p].rbegin()->first)
+				continue;
+			tempCost[p].insert(pair<float,int>(tempCorr,i));
+			if((int)tempCost[p].size() > pNoCand)
+			{
+				tempCostIter = tempCost[p].end();
+				tempCostIter--;
+				tempCost[p].erase(tempCostIter);
+			}
+		}
+	}
+	for(int p = 0; p<pNoPaths; p++)
+	{
+		tempCostIter = tempCost[p].begin();
+		for(int i = 0; i<pNoCand; i++, tempCostIter++)
+			pCandList[p*pNoCand+i] = tempCostIter->second;
+	}
 }
 
 // Function to compute the pre-cost of a path from SideInfo
@@ -205,9 +361,59 @@ float BaseOMP::computeCost( SideInfo* pSideInfo, int pNewElementID )
 {
 	int stepNo = (int)pSideInfo->mIndList.size();
 	pSideInfo->mIndList.push_back(pNewElementID);
-	addElementToRepresentation( mDict[pNewElementID], stepNo, pSideInfo->mQ, pSideInfo->mR[stepNo], pSideInfo->mZ, pSideInfo->mRes );
+	addElementToRepresentation( getAtom(pNewElementID), stepNo, pSideInfo->mQ, pSideInfo->mR[stepNo], pSideInfo->mZ, pSideInfo->mRes );
 	return l2Norm(pSideInfo->mRes,mM);
 }
+
+// Function to estimate the pre-cost of a path from SideInfo without updating it
+/// This function estimates the pre-cost of the path in pSideInfo after addition of pNewElementID as
+/// \f$\sqrt{\|r\|^2-c^2}\f$, where r is the residue and c the normalized correlation of the new atom with it.
+/// As r is orthogonal to the atoms already in the path, the exact projection removes \f$c^2\|a\|^2/\|a_\perp\|^2 \ge c^2\f$,
+/// so the estimate is never lower than the pre-cost computeCost returns. It takes one inner product, and pSideInfo is not modified.
+/// @param pSideInfo pointer to the SideInfo struct of the path
+/// @param pNewElementID ElementID of the new node in the path
+/// @return estimated pre-cost of the new path
+float BaseOMP::estimateCost( SideInfo* pSideInfo, int pNewElementID )
+{
+	float resNorm = computeInnerProd(pSideInfo->mRes,pSideInfo->mRes,mM);
+	float corr = computeInnerProd(getAtom(pNewElementID),pSideInfo->mRes,mM)/mDictNorm[pNewElementID];
+	return sqrt(max(resNorm-corr*corr,0.0f));
+}
+
+/// Comparison object for sorting atom indices wrt. decreasing correlation
+struct CorrelationGreater
+{
+	float* mCorr; ///< pointer to the vector of correlations indexed by atoms
+	bool operator()(unsigned int pID1, unsigned int pID2) const { return mCorr[pID1] > mCorr[pID2]; }
+};
+
+// Function to compute correlations of all dictionary atoms with my and sort the atoms wrt. them
+/// This function computes the normalized correlations of all atoms with my into mCorr, and sorts the atom indices
+/// wrt. decreasing correlation into mCorrOrder. Atoms with equal correlations keep their order in the dictionary.
+/// The priorities, the initial paths of length 1 and the first candidates of an empty path are read from mCorrOrder,
+/// so that the correlations with my are computed once per vector. If myCorr is set, they are not computed at all.
+void BaseOMP::computeInitialCorrelations()
+{
+	if(myCorr)
+	{
+		for(int i=0; i<mN;i++)
+			mCorr[i] = abs(myCorr[i])/mDictNorm[i];
+	}
+	else if(mOperator)
+		computeCorrelations(my);
+	else
+	{
+		for(int i=0; i<mN;i++)
+			mCorr[i] = abs(computeInnerProd(mDict[i],my,mM)/mDictNorm[i]);
+	}
+	for(int i=0; i<mN;i++)
+		mCorrOrder[i] = i;
+	CorrelationGreater corrGreater;
+	corrGreater.mCorr = mCorr;
+	stable_sort(mCorrOrder, mCorrOrder+mN, corrGreater);
+	mCorrOrderValid = true;
+}
+
 // Function to compute priorities of dictionary members
 /// This function computes the priorities of dictionary members wrt. their correlation to y.
 /// Members with high correlation to y get higher priorities in the A* trie, which stores nodes 
@@ -215,15 +421,12 @@ float BaseOMP::computeCost( SideInfo* pSideInfo, int pNewElementID )
 /// @param pPriority pointer to the array holding priorities (in the same order as the vectors in mDict)
 void BaseOMP::computePriorities( priority* pPriority )
 {
-	multimap<float,int,greater<float> > tempCost;
-	
-	for(int i=0; i<mN;i++)
-		tempCost.insert(pair<float,int>(abs( computeInnerProd(mDict[i],my,mM)/mDictNorm[i]),i));
+	if(!mCorrOrderValid)
+		computeInitialCorrelations();
 
-	multimap<float,int,greater<float> >::iterator tempCostIter = tempCost.begin();
-	for(int i=0;i<mN;i++,tempCostIter++)
+	for(int i=0;i<mN;i++)
 	{
-		pPriority[tempCostIter->second]=mN-i;
+		pPriority[mCorrOrder[i]]=mN-i;
 	}
 }
 // Function to perform necessary operations after A* search is terminated
@@ -257,6 +460,30 @@ SideInfo* BaseOMP::allocateSideInfo()
 	return newSideInfo;
 }
 
+// Function to delete an instance of SideInfo struct
+/// This function deletes pSideInfo and all arrays allocated for it by allocateSideInfo.
+/// @param pSideInfo pointer to the SideInfo struct to be deleted
+void BaseOMP::deleteSideInfo( SideInfo* pSideInfo )
+{
+	deleteFloatMatrix(pSideInfo->mQ,mK);
+	for(int i = 0; i<mK; i++)
+		delete[] pSideInfo->mR[i];
+	delete[] pSideInfo->mR;
+	delete[] pSideInfo->mZ;
+	delete[] pSideInfo->mRes;
+	delete pSideInfo;
+}
+
+// Function to return the number of bytes allocated for a SideInfo struct
+/// This function returns the memory allocated by allocateSideInfo: the struct, the K x M Q matrix, the K columns
+/// of R, z, the residue and the reserved index list.
+/// @return size of a SideInfo in bytes
+long BaseOMP::getSideInfoSize()
+{
+	return (long)sizeof(SideInfo) + 2*mK*(long)sizeof(float*) + mK*(long)sizeof(unsigned int)
+		+ ((long)mK*mM + mK*(mK+1)/2 + mK + mM)*(long)sizeof(float);
+}
+
 // Function to create a duplicate of a SideInfo struct
 /// This function creates a duplicate of the SideInfo struct pSrc and 
 /// returns a pointer to the duplicate.
@@ -383,6 +610,28 @@ void BaseOMP::findClosestVectorsIndList( float** pVectorArray, float* pVectorNor
 		pReturnList[i] = tempCostIter->second;
 }
 
+// Function to reconstruct the target vector by OMP
+/// This function reconstructs the target vector from my by OMP, i.e. along a single path that is expanded by the atom with
+/// the maximum correlation to the residue, with the same QR update as A*OMP. OMP stops when the termination criteria
+/// of isSearchComplete are satisfied (after one atom at least, as A*OMP), and the solution is stored in mSolution.
+/// @return true if the residue satisfies mEps, false if OMP stops with mK atoms only
+bool BaseOMP::runOMP()
+{
+	if(!mOMPSideInfo)
+		mOMPSideInfo = allocateSideInfo();
+	resetSideInfo(mOMPSideInfo);
+	float err;
+	elementID cand;
+	do
+	{
+		findBestCandidates(1, mOMPSideInfo, &cand);
+		err = computeCost(mOMPSideInfo, cand);
+	}
+	while(!isSearchComplete((int)mOMPSideInfo->mIndList.size(), err));
+	performPostOperations(mOMPSideInfo);
+	return err/mNorm_y <= mEps;
+}
+
 // Function to check if the termination criteria of A*OMP is satisfied
 /// This function checks if a specific path in search satisfies the termination criteria for A*OMP. The termination criteria
 /// are the maximum desired sparsity (mK) or allowable amount of error (mEps) in the reconstruction of the 
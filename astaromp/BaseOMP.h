@@ -26,6 +26,7 @@ karahanoglu@sabanciuniv.edu,  burak.karahanoglu@gmail.com
 #include "GlobalUtil.h"
 #include "VectorMath.h"
 #include "AStarDefinitions.h"
+#include "LinearOperator.h"
 
 using namespace std;
 
@@ -65,21 +66,39 @@ public:
 	/// Function to allocate an instance of SideInfo struct 
 	SideInfo* allocateSideInfo();
 
+	/// Function to delete an instance of SideInfo struct
+	void deleteSideInfo(SideInfo* pSideInfo);
+
+	/// Function to return the number of bytes allocated for a SideInfo struct
+	long getSideInfoSize();
+
 	/// Function to set mDict
 	void setDict(float** pDict);
 
+	/// Function to set mOperator
+	void setOperator(LinearOperator* pOperator);
+
 	/// Function to set y
 	void sety(float* py);
 
+	/// Function to set the precomputed inner products of the dictionary atoms with y
+	void setyCorrelations(float* pyCorr);
+
 	/// Function to compute priorities of dictionary members
 	void computePriorities(priority* pPriority);
 
 	/// Function to compute the pre-cost of a path from SideInfo
 	float computeCost(SideInfo* pSideInfo, int pNewElementID);
 
+	/// Function to estimate the pre-cost of a path from SideInfo without updating it
+	float estimateCost(SideInfo* pSideInfo, int pNewElementID);
+
 	/// Function to find the best candidates for expansion of a path
 	void findBestCandidates(  int pNoCand, SideInfo* pSideInfo, elementID* pCandList  );
 
+	/// Function to find the best candidates for expansion of a set of paths
+	void findBestCandidatesBatch(  int pNoCand, SideInfo** pSideInfos, int pNoPaths, elementID* pCandList  );
+
 	/// Function to perform necessary operations after A* search is terminated
 	void performPostOperations(  SideInfo* pSideInfo  );
 
@@ -104,6 +123,9 @@ public:
 	/// Function to initialize paths for A*OMP
 	int findInitialPaths( int pNoInitialPaths, vector<unsigned int*> *pNodeList, int &pNodesPerPath);
 
+	/// Function to reconstruct the target vector by OMP
+	bool runOMP();
+
 private:
 	/// Function to solve for the coefficients from a QR decomposition
 	void solveCoefs(vector<unsigned int> *pIndList, float* pZ, float** pR);
@@ -117,6 +139,18 @@ private:
 	/// Function to find a sorted list of vectors which lie closest to a vector among an array of vectors 
 	void findClosestVectorsIndList( float** pVectorArray, float* pVectorNorm, float* pVector,unsigned int* pReturnList ,int pNoVectors, int pReturnSize, int pSize );
 	
+	/// Function to return a dictionary atom
+	float* getAtom(int pID);
+
+	/// Function to compute correlations of all dictionary atoms with a vector via mOperator
+	void computeCorrelations(float* pVector);
+
+	/// Function to compute correlations of all dictionary atoms with my and sort the atoms wrt. them
+	void computeInitialCorrelations();
+
+	/// Function to find a sorted list of dictionary atoms which lie closest to a vector
+	map<float,int,greater<float> > * findClosestAtoms( float* pVector, int pReturnSize );
+
 	/// Function to find the initial paths for A*OMP
 	int findInitialPaths1( int pNoInitialPaths, vector<unsigned int*> *pNodeList );
 
@@ -128,11 +162,18 @@ private:
 	int mN;				///< dimension of the desired sparse vectors
 	int mM;				///< number of observations
 	float **mDict;		///< pointer to the matrix containing the dictionary (holographic basis)
+	LinearOperator* mOperator;	///< pointer to the operator that replaces mDict (NULL if mDict is used)
+	float* mCorr;		///< pointer to the vector of correlations computed via mOperator
+	float* myCorr;		///< pointer to the precomputed inner products of the atoms with my (NULL if not provided)
+	unsigned int* mCorrOrder;	///< pointer to the indices of atoms sorted wrt. decreasing correlation with my
+	bool mCorrOrderValid;	///< states if mCorrOrder is computed for the current my
+	float* mAtom;		///< pointer to the dictionary atom generated by mOperator
 	float* mDictNorm;	///< pointer to the vector holding norms of dictionary elements
 	float* my;			///< pointer to the observed vector
 	float mNorm_y;		///< norm of the observation vector
 	float* mSolution;	///< pointer to the vector holding the solution
 	float mEps;			///< error toleration for terminating the search
 	int mNodesPerInitPath; ///< number of nodes in each initial path (1 or 2)
+	SideInfo* mOMPSideInfo;	///< pointer to the SideInfo of the OMP path (allocated at the first call to runOMP)
 };
 
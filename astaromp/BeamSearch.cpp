@@ -0,0 +1,169 @@
+#include "BeamSearch.h"
+
+// Constructor
+/// This is the constructor function for BeamSearch class. It allocates the SideInfos of mW beams and mW x mB new paths.
+/// @param pW beam width (mW)
+/// @param pB number of extensions per path (mB)
+/// @param pK desired path length (mK)
+/// @param pProblem pointer to the problem class (mProblem)
+BeamSearch::BeamSearch( int pW, int pB, int pK, BaseOMP* pProblem )
+{
+	mW = pW;
+	mB = pB;
+	mK = pK;
+	mProblem = pProblem;
+	mBeams = new SideInfo*[mW];
+	for(int i = 0; i<mW; i++)
+		mBeams[i] = mProblem->allocateSideInfo();
+	mChildren = new SideInfo*[mW*mB];
+	for(int i = 0; i<mW*mB; i++)
+		mChildren[i] = mProblem->allocateSideInfo();
+	mChildCost = new float[mW*mB];
+	mChildKey = new unsigned long[mW*mB];
+	mCandList = new elementID[mW*mB];
+	mNoBeams = 0;
+	mNoLevels = 0;
+	mNoEvaluations = 0;
+	mNoEqBranch = 0;
+}
+
+// Destructor
+/// This is the destructor for BeamSearch class.
+BeamSearch::~BeamSearch()
+{
+	for(int i = 0; i<mW; i++)
+		mProblem->deleteSideInfo(mBeams[i]);
+	for(int i = 0; i<mW*mB; i++)
+		mProblem->deleteSideInfo(mChildren[i]);
+	delete[] mBeams;
+	delete[] mChildren;
+	delete[] mChildCost;
+	delete[] mChildKey;
+	delete[] mCandList;
+}
+
+// Function to run beam search for the observation set in the problem class
+/// This function reconstructs the target vector from the observation vector of mProblem. The search starts from a
+/// single empty path. At each level, the mB best candidates of all beams are found by BaseOMP::findBestCandidatesBatch,
+/// the new paths are evaluated, and the mW paths with the lowest residues become the beams of the next level.
+/// The solution is extracted from the best beam into the problem class, as A* search does.
+/// @return 1
+int BeamSearch::run()
+{
+	multimap<float,int> bestChildren;
+	multimap<float,int>::iterator childIter;
+	mNoLevels = 0;
+	mNoEvaluations = 0;
+	mNoEqBranch = 0;
+	mProblem->resetSideInfo(mBeams[0]);
+	mNoBeams = 1;
+	float bestCost = mProblem->getNorm_y();
+	do
+	{
+		mProblem->findBestCandidatesBatch(mB, mBeams, mNoBeams, mCandList);
+		int noChildren = 0;
+		for(int i = 0; i<mNoBeams; i++)
+		{
+			unsigned long parentKey = computeKey(mBeams[i]->mIndList);
+			for(int j = 0; j<mB; j++)
+			{
+				elementID cand = mCandList[i*mB+j];
+				unsigned long key = parentKey + cand*2654435761UL;
+				if(isEquivalent(mBeams[i], cand, key, noChildren))
+				{
+					mNoEqBranch++;
+					continue;
+				}
+				mChildKey[noChildren] = key;
+				mProblem->copySideInfo(mBeams[i], mChildren[noChildren]);
+				mChildCost[noChildren] = mProblem->computeCost(mChildren[noChildren], cand);
+				noChildren++;
+			}
+		}
+		mNoEvaluations += noChildren;
+		if(noChildren == 0)
+			break;
+
+		// the mW best new paths become the beams (SideInfos are swapped, not copied)
+		bestChildren.clear();
+		for(int i = 0; i<noChildren; i++)
+			bestChildren.insert(pair<float,int>(mChildCost[i],i));
+		mNoBeams = 0;
+		for(childIter = bestChildren.begin(); childIter != bestChildren.end() && mNoBeams<mW; childIter++)
+		{
+			swap(mBeams[mNoBeams], mChildren[childIter->second]);
+			mNoBeams++;
+		}
+		bestCost = bestChildren.begin()->first;
+		mNoLevels++;
+	}
+	while(!mProblem->isSearchComplete(mNoLevels, bestCost));
+
+	mProblem->performPostOperations(mBeams[0]);
+	return 1;
+}
+
+// Function to check if a new path is equivalent to one of the new paths of the level
+/// This function checks if the path obtained by adding pNewElementID to pParent consists of the same atoms as one of the
+/// first pNoChildren new paths of the level, which all have one atom more than their parents. The atom lists are
+/// compared only for paths with equal keys. A new atom that is already in pParent also gives an equivalent path.
+/// @param pParent pointer to the SideInfo of the path to be extended
+/// @param pNewElementID elementID of the new atom
+/// @param pKey key of the new path (computeKey)
+/// @param pNoChildren number of new paths of the level so far
+/// @return true if an equivalent path exists
+bool BeamSearch::isEquivalent( SideInfo* pParent, elementID pNewElementID, unsigned long pKey, int pNoChildren )
+{
+	vector<unsigned int> &parentList = pParent->mIndList;
+	if(find(parentList.begin(), parentList.end(), pNewElementID) != parentList.end())
+		return true;
+	for(int c = 0; c<pNoChildren; c++)
+	{
+		if(mChildKey[c] != pKey)
+			continue;
+		vector<unsigned int> &childList = mChildren[c]->mIndList;
+		bool equal = true;
+		for(int i = 0; i<(int)childList.size() && equal; i++)
+		{
+			equal = (childList[i] == pNewElementID ||
+				find(parentList.begin(), parentList.end(), childList[i]) != parentList.end());
+		}
+		if(equal)
+			return true;
+	}
+	return false;
+}
+
+// Function to compute the key of a set of atoms
+/// This function computes a key that does not depend on the order of the atoms in pIndList, as the sum of their
+/// multiplicative hashes. Equivalent paths have equal keys.
+/// @param pIndList list of atoms
+/// @return key of the set of atoms
+unsigned long BeamSearch::computeKey( vector<unsigned int> &pIndList )
+{
+	unsigned long key = 0;
+	for(int i = 0; i<(int)pIndList.size(); i++)
+		key += pIndList[i]*2654435761UL;
+	return key;
+}
+
+// Function to get mNoLevels
+/// @return mNoLevels
+int BeamSearch::getNoLevels()
+{
+	return mNoLevels;
+}
+
+// Function to get mNoEvaluations
+/// @return mNoEvaluations
+int BeamSearch::getNoEvaluations()
+{
+	return mNoEvaluations;
+}
+
+// Function to get mNoEqBranch
+/// @return mNoEqBranch
+int BeamSearch::getNoEqBranch()
+{
+	return mNoEqBranch;
+}
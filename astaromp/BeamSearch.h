@@ -0,0 +1,73 @@
+/*
+This source code is provided as a part of AStarOMP project.
+
+Using, altering and redistributing this software is permitted to anyone for academical purposes,
+with to the following restrictions:
+
+1 - Original code shall not be misrepresented.
+
+2 - Modifications made to the code should be clearly indicated.
+
+3 - You must not claim that this is your own code.
+
+4 - This note may not be removed or modified.
+
+In case you use this code in a product, an acknowledgment in documentation would be appreciated.
+
+The author cannot be held responsible for any damages that arise from using this software.
+
+Nazim Burak Karahanoglu
+karahanoglu@sabanciuniv.edu,  burak.karahanoglu@gmail.com
+*/
+
+#pragma once
+#include "BaseOMP.h"
+
+/// BeamSearch is a fixed width alternative to A* search for A*OMP, for reconstruction with a hard time budget.
+/// It keeps mW paths (beams) of equal length and extends them level by level: the mB best candidates of all beams are
+/// found in one pass over the dictionary, the new paths are evaluated exactly by BaseOMP::computeCost, and the mW best
+/// of them become the beams of the next level. Equivalent paths (equal sets of atoms) are evaluated once.
+/// The search stops when the best beam satisfies the termination criteria of BaseOMP, so that it takes at most mK
+/// levels of at most mW x mB evaluations each. All SideInfos are allocated by the constructor.
+class BeamSearch
+{
+public:
+	/// Constructor
+	BeamSearch(int pW, int pB, int pK, BaseOMP* pProblem);
+
+	/// Destructor
+	~BeamSearch();
+
+	/// Function to run beam search for the observation set in the problem class
+	int run();
+
+	/// Function to get mNoLevels
+	int getNoLevels();
+
+	/// Function to get mNoEvaluations
+	int getNoEvaluations();
+
+	/// Function to get mNoEqBranch
+	int getNoEqBranch();
+
+private:
+	/// Function to check if a new path is equivalent to one of the new paths of the level
+	bool isEquivalent(SideInfo* pParent, elementID pNewElementID, unsigned long pKey, int pNoChildren);
+
+	/// Function to compute the key of a set of atoms
+	unsigned long computeKey(vector<unsigned int> &pIndList);
+
+	int mW;		///< beam width: number of paths kept per level
+	int mB;		///< number of extensions per path
+	int mK;		///< desired path length
+	BaseOMP* mProblem;		///< pointer to the problem class
+	SideInfo** mBeams;		///< pointer to the array of SideInfos of the beams (mW)
+	SideInfo** mChildren;	///< pointer to the array of SideInfos of the new paths of a level (mW x mB)
+	float* mChildCost;		///< pointer to the array of pre-costs of the new paths
+	unsigned long* mChildKey;	///< pointer to the array of keys of the new paths (for finding equivalent paths)
+	elementID* mCandList;	///< pointer to the array of candidates of the beams (mB per beam)
+	int mNoBeams;			///< number of beams at the current level
+	int mNoLevels;			///< number of levels of the last search
+	int mNoEvaluations;		///< number of paths evaluated in the last search
+	int mNoEqBranch;		///< number of equivalent paths found in the last search
+};
@@ -0,0 +1,329 @@
+#include "LinearOperator.h"
+
+// Constructor
+/// This is the constructor function for LinearOperator class.
+/// @param pM number of rows of the operator (number of observations)
+/// @param pN number of columns of the operator (dictionary size)
+LinearOperator::LinearOperator( int pM, int pN )
+{
+	mM = pM;
+	mN = pN;
+}
+
+// Destructor
+/// This is the destructor for LinearOperator class.
+LinearOperator::~LinearOperator()
+{
+}
+
+// Function to compute the l2 norms of the columns of the operator
+/// This function computes the \f$l_2\f$ norms of the columns of the operator one by one
+/// from getColumn. Derived classes override it when the norms are known in closed form.
+/// @param pNorms pointer to the array of length N in which the norms are returned
+void LinearOperator::computeColumnNorms( float* pNorms )
+{
+	float* column = new float[mM];
+	for(int i = 0; i<mN; i++)
+	{
+		getColumn(i,column);
+		pNorms[i] = l2Norm(column,mM);
+	}
+	delete[] column;
+}
+
+// Function to return the number of rows
+/// @return number of rows (observations)
+int LinearOperator::getM()
+{
+	return mM;
+}
+
+// Function to return the number of columns
+/// @return number of columns (dictionary size)
+int LinearOperator::getN()
+{
+	return mN;
+}
+
+// Constructor
+/// This is the constructor function for SubsampledTransform class. The row list is copied.
+/// @param pM number of selected rows
+/// @param pN order of the transform (power of 2)
+/// @param pRows pointer to the array of selected rows, distinct and in increasing order
+SubsampledTransform::SubsampledTransform( int pM, int pN, int* pRows ) : LinearOperator(pM,pN)
+{
+	mRows = new int[mM];
+	memcpy(mRows,pRows,mM*sizeof(int));
+	mBuffer = new float[mN];
+}
+
+// Destructor
+/// This is the destructor for SubsampledTransform class.
+SubsampledTransform::~SubsampledTransform()
+{
+	delete[] mRows;
+	delete[] mBuffer;
+}
+
+// Function to apply the operator to a vector
+/// This function computes \f$y = \Phi x\f$ by transforming x and picking the selected rows.
+/// @param pX pointer to the vector of length N
+/// @param pY pointer to the vector of length M in which the product is returned
+void SubsampledTransform::apply( float* pX, float* pY )
+{
+	copyVector(pX,mBuffer,mN);
+	transform_I(mBuffer);
+	for(int i = 0; i<mM; i++)
+		pY[i] = mBuffer[mRows[i]];
+}
+
+// Function to apply the transpose of the operator to a vector
+/// This function computes \f$c = \Phi^Tr\f$ by scattering r into the selected rows of a zero
+/// vector and applying the inverse transform.
+/// @param pR pointer to the vector of length M
+/// @param pC pointer to the vector of length N in which the product is returned
+void SubsampledTransform::applyTranspose( float* pR, float* pC )
+{
+	memset(pC,0,mN*sizeof(float));
+	for(int i = 0; i<mM; i++)
+		pC[mRows[i]] = pR[i];
+	inverseTransform_I(pC);
+}
+
+// Function to generate a column of the operator
+/// This function computes the pID'th column of the operator from the entries of the selected rows.
+/// @param pID index of the column
+/// @param pColumn pointer to the vector of length M in which the column is returned
+void SubsampledTransform::getColumn( int pID, float* pColumn )
+{
+	for(int i = 0; i<mM; i++)
+		pColumn[i] = getEntry(mRows[i],pID);
+}
+
+// Constructor
+/// This is the constructor function for HadamardOperator class.
+/// @param pM number of selected rows
+/// @param pN order of the transform (power of 2)
+/// @param pRows pointer to the array of selected rows, distinct and in increasing order
+HadamardOperator::HadamardOperator( int pM, int pN, int* pRows ) : SubsampledTransform(pM,pN,pRows)
+{
+}
+
+// Function to apply the orthonormal Walsh-Hadamard transform
+void HadamardOperator::transform_I( float* pSrcDst )
+{
+	fwht_I(pSrcDst,mN);
+	multVectorwithScalar_I(pSrcDst,1.0f/sqrt((float)mN),mN);
+}
+
+// Function to apply the inverse Walsh-Hadamard transform
+/// The orthonormal Walsh-Hadamard matrix is symmetric and its own inverse.
+void HadamardOperator::inverseTransform_I( float* pSrcDst )
+{
+	transform_I(pSrcDst);
+}
+
+// Function to compute an entry of the orthonormal Walsh-Hadamard transform
+/// @return \f$(-1)^{b}/\sqrt{N}\f$, where b is the parity of the common bits of pRow and pCol
+float HadamardOperator::getEntry( int pRow, int pCol )
+{
+	int common = pRow & pCol;
+	int parity = 0;
+	while(common)
+	{
+		parity ^= 1;
+		common &= common-1;
+	}
+	return (parity ? -1.0f : 1.0f)/sqrt((float)mN);
+}
+
+// Function to compute the l2 norms of the columns of the operator
+/// All entries are \f$\pm 1/\sqrt{N}\f$, so all columns have norm \f$\sqrt{M/N}\f$.
+void HadamardOperator::computeColumnNorms( float* pNorms )
+{
+	for(int i = 0; i<mN; i++)
+		pNorms[i] = sqrt((float)mM/mN);
+}
+
+// Constructor
+/// This is the constructor function for DCTOperator class. It computes the FFT tables.
+/// @param pM number of selected rows
+/// @param pN order of the transform (power of 2)
+/// @param pRows pointer to the array of selected rows, distinct and in increasing order
+DCTOperator::DCTOperator( int pM, int pN, int* pRows ) : SubsampledTransform(pM,pN,pRows)
+{
+	const double pi = acos(-1.0);
+	mTwiddle = new complex<float>[mN/2+1];
+	mShift = new complex<float>[mN];
+	mFFTBuffer = new complex<float>[mN];
+	mBitReversal = new int[mN];
+	for(int k = 0; k<mN/2; k++)
+		mTwiddle[k] = complex<float>((float)cos(2*pi*k/mN),(float)-sin(2*pi*k/mN));
+	for(int k = 0; k<mN; k++)
+		mShift[k] = complex<float>((float)cos(pi*k/(2*mN)),(float)-sin(pi*k/(2*mN)));
+	mBitReversal[0] = 0;
+	for(int i = 1, j = 0; i<mN; i++)
+	{
+		int bit = mN>>1;
+		for(; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+		mBitReversal[i] = j;
+	}
+	mC0 = sqrt(1.0f/mN);
+	mC1 = sqrt(2.0f/mN);
+}
+
+// Destructor
+/// This is the destructor for DCTOperator class.
+DCTOperator::~DCTOperator()
+{
+	delete[] mTwiddle;
+	delete[] mShift;
+	delete[] mFFTBuffer;
+	delete[] mBitReversal;
+}
+
+// Function to compute the FFT of mFFTBuffer
+/// This function computes the complex FFT of length N of mFFTBuffer in place by radix 2 butterflies.
+/// The inverse transform is not divided by N.
+/// @param pInverse true for the inverse transform
+void DCTOperator::fft_I( bool pInverse )
+{
+	for(int i = 0; i<mN; i++)
+	{
+		if(i < mBitReversal[i])
+			swap(mFFTBuffer[i],mFFTBuffer[mBitReversal[i]]);
+	}
+	for(int len = 2; len<=mN; len *= 2)
+	{
+		int half = len/2;
+		int step = mN/len;
+		for(int i = 0; i<mN; i += len)
+		{
+			for(int j = 0; j<half; j++)
+			{
+				complex<float> w = pInverse ? conj(mTwiddle[j*step]) : mTwiddle[j*step];
+				complex<float> u = mFFTBuffer[i+j];
+				complex<float> v = mFFTBuffer[i+j+half]*w;
+				mFFTBuffer[i+j] = u+v;
+				mFFTBuffer[i+j+half] = u-v;
+			}
+		}
+	}
+}
+
+// Function to apply the orthonormal DCT-II
+/// This function computes \f$X_k = c_k\sum_j x_j\cos(\pi(2j+1)k/2N)\f$ from the FFT of the even samples
+/// followed by the odd samples in reverse order (Makhoul).
+void DCTOperator::transform_I( float* pSrcDst )
+{
+	for(int k = 0; k<mN/2; k++)
+	{
+		mFFTBuffer[k] = pSrcDst[2*k];
+		mFFTBuffer[mN-1-k] = pSrcDst[2*k+1];
+	}
+	fft_I(false);
+	pSrcDst[0] = mC0*mFFTBuffer[0].real();
+	for(int k = 1; k<mN; k++)
+		pSrcDst[k] = mC1*(mShift[k]*mFFTBuffer[k]).real();
+}
+
+// Function to apply the inverse DCT
+/// This function inverts transform_I with one inverse FFT.
+void DCTOperator::inverseTransform_I( float* pSrcDst )
+{
+	mFFTBuffer[0] = pSrcDst[0]/mC0;
+	for(int k = 1; k<mN; k++)
+		mFFTBuffer[k] = conj(mShift[k])*complex<float>(pSrcDst[k],-pSrcDst[mN-k])/mC1;
+	fft_I(true);
+	for(int k = 0; k<mN/2; k++)
+	{
+		pSrcDst[2*k] = mFFTBuffer[k].real()/mN;
+		pSrcDst[2*k+1] = mFFTBuffer[mN-1-k].real()/mN;
+	}
+}
+
+// Function to compute an entry of the orthonormal DCT-II
+/// @return \f$c_k\cos(\pi(2j+1)k/2N)\f$ for row k and column j
+float DCTOperator::getEntry( int pRow, int pCol )
+{
+	const double pi = acos(-1.0);
+	return (pRow ? mC1 : mC0)*(float)cos(pi*(2.0*pCol+1)*pRow/(2.0*mN));
+}
+
+// Function to compute the l2 norms of the columns of the operator
+/// With \f$\cos^2 a = (1+\cos 2a)/2\f$, the squared norm of column j is a constant plus a cosine sum
+/// over the doubled row frequencies 2k. Frequencies above N are folded back (\f$C_{2N-q} = -C_q\f$,
+/// \f$C_N = 0\f$), so all N norms take one inverse DCT instead of M x N entries.
+void DCTOperator::computeColumnNorms( float* pNorms )
+{
+	float base = 0.0f;
+	memset(mBuffer,0,mN*sizeof(float));
+	for(int i = 0; i<mM; i++)
+	{
+		int k = mRows[i];
+		int q = 2*k;
+		float c2 = k ? 0.5f*mC1*mC1 : 0.5f*mC0*mC0;
+		base += c2;
+		if(q < mN)
+			mBuffer[q] += c2;
+		else if(q > mN)
+			mBuffer[2*mN-q] -= c2;
+	}
+	// the inverse DCT sums c_q X_q cos(.), so the coefficients are divided by c_q
+	mBuffer[0] /= mC0;
+	for(int q = 1; q<mN; q++)
+		mBuffer[q] /= mC1;
+	inverseTransform_I(mBuffer);
+	for(int j = 0; j<mN; j++)
+		pNorms[j] = sqrt(max(base+mBuffer[j],0.0f));
+}
+
+// Function to apply the unnormalized fast Walsh-Hadamard transform
+/// This function computes the Walsh-Hadamard transform of pSrcDst in natural order and in place.
+/// Applying it twice multiplies the vector by pSize.
+/// @param pSrcDst pointer to the vector
+/// @param pSize length of the vector (power of 2)
+void fwht_I( float* pSrcDst, int pSize )
+{
+	for(int h = 1; h<pSize; h *= 2)
+	{
+		for(int i = 0; i<pSize; i += 2*h)
+		{
+			for(int j = i; j<i+h; j++)
+			{
+				float u = pSrcDst[j];
+				float v = pSrcDst[j+h];
+				pSrcDst[j] = u+v;
+				pSrcDst[j+h] = u-v;
+			}
+		}
+	}
+}
+
+// Function to select distinct rows of a transform at random
+/// This function selects pM distinct rows out of pN with rand() and returns them in increasing order.
+/// @param pRows pointer to the array of length pM in which the rows are returned
+/// @param pM number of rows to select
+/// @param pN order of the transform
+void selectRandomRows( int* pRows, int pM, int pN )
+{
+	bool* picked = new bool[pN];
+	memset(picked,0,pN*sizeof(bool));
+	for(int i = 0; i<pM; )
+	{
+		int j = rand()%pN;
+		if(!picked[j])
+		{
+			picked[j] = true;
+			i++;
+		}
+	}
+	for(int i = 0, j = 0; j<pN; j++)
+	{
+		if(picked[j])
+			pRows[i++] = j;
+	}
+	delete[] picked;
+}
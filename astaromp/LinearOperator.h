@@ -0,0 +1,163 @@
+/*
+This source code is provided as a part of AStarOMP project.
+
+Using, altering and redistributing this software is permitted to anyone for academical purposes,
+with to the following restrictions:
+
+1 - Original code shall not be misrepresented.
+
+2 - Modifications made to the code should be clearly indicated.
+
+3 - You must not claim that this is your own code.
+
+4 - This note may not be removed or modified.
+
+In case you use this code in a product, an acknowledgment in documentation would be appreciated.
+
+The author cannot be held responsible for any damages that arise from using this software.
+
+Nazim Burak Karahanoglu
+karahanoglu@sabanciuniv.edu,  burak.karahanoglu@gmail.com
+*/
+
+#pragma once
+#include <complex>
+#include "VectorMath.h"
+
+using namespace std;
+
+/// LinearOperator is the interface for an observation matrix that is applied instead of stored.
+/// BaseOMP uses it in place of an explicit dictionary: correlations of all atoms with a residue
+/// are computed by applyTranspose, and only the atoms that enter a path are generated, one
+/// column at a time, by getColumn.
+class LinearOperator
+{
+public:
+	/// Constructor
+	LinearOperator(int pM, int pN);
+
+	/// Destructor
+	virtual ~LinearOperator();
+
+	/// Function to apply the operator to a vector
+	virtual void apply(float* pX, float* pY) = 0;
+
+	/// Function to apply the transpose of the operator to a vector
+	virtual void applyTranspose(float* pR, float* pC) = 0;
+
+	/// Function to generate a column of the operator
+	virtual void getColumn(int pID, float* pColumn) = 0;
+
+	/// Function to compute the \f$l_2\f$ norms of the columns of the operator
+	virtual void computeColumnNorms(float* pNorms);
+
+	/// Function to return the number of rows (observations)
+	int getM();
+
+	/// Function to return the number of columns (dictionary size)
+	int getN();
+
+protected:
+	int mM;		///< number of rows (observations)
+	int mN;		///< number of columns (dictionary size)
+};
+
+/// SubsampledTransform is a LinearOperator made of M rows of an orthonormal transform of order N,
+/// where N is a power of 2. Products with the operator and its transpose take one fast transform
+/// of length N each, and the storage is the row list and O(N) workspace instead of the M x N
+/// dictionary.
+class SubsampledTransform : public LinearOperator
+{
+public:
+	/// Constructor
+	SubsampledTransform(int pM, int pN, int* pRows);
+
+	/// Destructor
+	virtual ~SubsampledTransform();
+
+	/// Function to apply the operator to a vector
+	void apply(float* pX, float* pY);
+
+	/// Function to apply the transpose of the operator to a vector
+	void applyTranspose(float* pR, float* pC);
+
+	/// Function to generate a column of the operator
+	void getColumn(int pID, float* pColumn);
+
+protected:
+	/// Function to apply the orthonormal transform (in-place operation)
+	virtual void transform_I(float* pSrcDst) = 0;
+
+	/// Function to apply the inverse (transpose) of the orthonormal transform (in-place operation)
+	virtual void inverseTransform_I(float* pSrcDst) = 0;
+
+	/// Function to compute an entry of the orthonormal transform
+	virtual float getEntry(int pRow, int pCol) = 0;
+
+	int* mRows;		///< pointer to the array of selected rows (increasing)
+	float* mBuffer;	///< pointer to the workspace of length N
+};
+
+/// HadamardOperator is a SubsampledTransform of the Walsh-Hadamard transform (natural order),
+/// scaled by \f$1/\sqrt{N}\f$. All entries are \f$\pm 1/\sqrt{N}\f$.
+class HadamardOperator : public SubsampledTransform
+{
+public:
+	/// Constructor
+	HadamardOperator(int pM, int pN, int* pRows);
+
+	/// Function to compute the \f$l_2\f$ norms of the columns of the operator
+	void computeColumnNorms(float* pNorms);
+
+protected:
+	/// Function to apply the orthonormal Walsh-Hadamard transform (in-place operation)
+	void transform_I(float* pSrcDst);
+
+	/// Function to apply the inverse Walsh-Hadamard transform (in-place operation)
+	void inverseTransform_I(float* pSrcDst);
+
+	/// Function to compute an entry of the orthonormal Walsh-Hadamard transform
+	float getEntry(int pRow, int pCol);
+};
+
+/// DCTOperator is a SubsampledTransform of the orthonormal DCT-II. The DCT and its inverse are
+/// computed by one complex FFT of length N each.
+class DCTOperator : public SubsampledTransform
+{
+public:
+	/// Constructor
+	DCTOperator(int pM, int pN, int* pRows);
+
+	/// Destructor
+	~DCTOperator();
+
+	/// Function to compute the \f$l_2\f$ norms of the columns of the operator
+	void computeColumnNorms(float* pNorms);
+
+protected:
+	/// Function to apply the orthonormal DCT-II (in-place operation)
+	void transform_I(float* pSrcDst);
+
+	/// Function to apply the inverse DCT, i.e. the DCT-III (in-place operation)
+	void inverseTransform_I(float* pSrcDst);
+
+	/// Function to compute an entry of the orthonormal DCT-II
+	float getEntry(int pRow, int pCol);
+
+private:
+	/// Function to compute the FFT of mFFTBuffer (in-place operation)
+	void fft_I(bool pInverse);
+
+	complex<float>* mTwiddle;		///< pointer to the FFT twiddle factors \f$e^{-2\pi ik/N}\f$, k < N/2
+	complex<float>* mShift;			///< pointer to the DCT phase factors \f$e^{-i\pi k/2N}\f$
+	complex<float>* mFFTBuffer;		///< pointer to the FFT workspace of length N
+	int* mBitReversal;				///< pointer to the bit reversal permutation of length N
+	float mC0;						///< scale of the DC row, \f$\sqrt{1/N}\f$
+	float mC1;						///< scale of the other rows, \f$\sqrt{2/N}\f$
+};
+
+/// Function to apply the unnormalized fast Walsh-Hadamard transform (in-place operation)
+void fwht_I(float* pSrcDst, int pSize);
+
+/// Function to select distinct rows of a transform at random
+void selectRandomRows(int* pRows, int pM, int pN);
@@ -5,6 +5,7 @@ Trie::Trie(void)
 {
 	mRoot = new TrieNode;
 	mRoot->makeRoot();
+	mNoNodes = 0;
 }
 
 // Default destructor
@@ -87,6 +88,7 @@ TrieNode *Trie:: addSubPathToNode(TrieNode* pCurrentNode, vector<elementID> *pSu
 			newNode->setParent(pCurrentNode);
 			pCurrentNode->setChild(newNode);
 			pCurrentNode = newNode;
+			mNoNodes++;
 		}
 	}
 	if(pCurrentNode->isFinal())
@@ -110,6 +112,7 @@ void Trie::clearTrie()
 		myIter = mRoot->getChildren()->begin();
 		delete myIter->second;
 	}
+	mNoNodes = 0;
 }
 
 // Function to set the mPriority vector
@@ -120,6 +123,77 @@ void Trie::setPriority( priority* pPriority )
 	mPriority = pPriority;
 }
 
+// Function to remove a path from the trie
+/// This function removes the path with leaf node pLeafNode from the trie, so that the same path can be added again.
+/// The leaf is no longer final, and it is deleted with its ancestors as long as these have no children and are not
+/// final, i.e. they belong to no other path.
+/// @param pLeafNode pointer to the leaf node of the path to be removed
+void Trie::removePath( TrieNode* pLeafNode )
+{
+	TrieNode* parentNode;
+	pLeafNode->setFinal(false);
+	while(!pLeafNode->isRoot() && !pLeafNode->isFinal() && pLeafNode->getChildren()->size() == 0)
+	{
+		parentNode = pLeafNode->getParent();
+		delete pLeafNode;		//removes itself from the children of its parent
+		mNoNodes--;
+		pLeafNode = parentNode;
+	}
+}
+
+// Function to remove all nodes that do not belong to a given set of paths
+/// This function removes the nodes of the trie that are neither in pLeafNodes nor ancestors of a node in pLeafNodes,
+/// i.e. it keeps only the paths whose leaf nodes are given. Pointers to the kept nodes remain valid.
+/// @param pLeafNodes pointer to the set of leaf nodes of the paths to be kept
+/// @return number of removed nodes
+int Trie::pruneTrie( set<TrieNode*> *pLeafNodes )
+{
+	int noNodes = mNoNodes;
+	pruneSubTrie(mRoot, pLeafNodes);
+	return noNodes - mNoNodes;
+}
+
+// Function to remove the nodes below a node that do not belong to a given set of paths
+/// This function removes the descendants of pNode that are neither in pLeafNodes nor ancestors of a node in pLeafNodes,
+/// and pNode itself if it has no descendants left and is not in pLeafNodes (the root is never removed).
+/// @param pNode pointer to the node
+/// @param pLeafNodes pointer to the set of leaf nodes of the paths to be kept
+/// @return true if pNode is removed
+bool Trie::pruneSubTrie( TrieNode* pNode, set<TrieNode*> *pLeafNodes )
+{
+	if(pNode->getChildren()->size() != 0)
+	{
+		childrenMapIter myIter = pNode->getChildren()->begin();
+		while(myIter != pNode->getChildren()->end())
+		{
+			TrieNode* child = myIter->second;
+			myIter++;		//child removes itself from the children of pNode
+			pruneSubTrie(child, pLeafNodes);
+		}
+	}
+	if(pNode->getChildren()->size() != 0 || pNode->isRoot() || pLeafNodes->count(pNode))
+		return false;
+	delete pNode;
+	mNoNodes--;
+	return true;
+}
+
+// Function to get mNoNodes
+/// @return mNoNodes
+int Trie::getNoNodes()
+{
+	return mNoNodes;
+}
+
+// Function to return the number of bytes allocated for a node
+/// This function returns the size of a TrieNode and of its entry in the childrenMap of its parent, i.e. the
+/// (elementID, TrieNode*) pair and the three links and color of a map node.
+/// @return size of a node in bytes
+long Trie::getNodeSize()
+{
+	return (long)sizeof(TrieNode) + (long)sizeof(pair<elementID,TrieNode*>) + 4*(long)sizeof(void*);
+}
+
 // Function that returns the priority of a node
 /// This function returns the priority of pNode.
 /// @param pNode pointer to the node whose priority is requested
@@ -27,6 +27,7 @@ karahanoglu@sabanciuniv.edu,  burak.karahanoglu@gmail.com
 
 #include "TrieNode.h"
 #include <limits.h>
+#include <set>
 
 /// This class implements a trie structure to be used as A* search tree.
 /// "Trie" class handles addition of nodes and paths to the trie in addition to ordering of nodes in a path wrt. their priorities. 
@@ -37,8 +38,11 @@ karahanoglu@sabanciuniv.edu,  burak.karahanoglu@gmail.com
 // In order to add a node or nodes to a path, one should explicitely 
 /// provide a pointer to the leaf node of the path to which the node/nodes should be added. Once a node/nodes are added, Trie class returns the leaf 
 /// node to the new path, which should be handled outside this class to add further nodes to the same path.
-/// Removing nodes has not been implemented as nodes are not removed at all. We keep the path in the trie eventhough it is removed from the search 
+/// Nodes are not removed when a path is pruned. We keep the path in the trie eventhough it is removed from the search 
 /// as we would like to avoid later equivalent paths. This does not affect active paths, as they are stored in SearchStack.
+/// Only the memory-bounded search removes paths (removePath), so that the trie does not grow beyond the memory budget
+/// and the removed paths may be found again. It may also remove the nodes of all pruned and expanded paths (pruneTrie),
+/// at the cost of exploring equivalent paths again.
 ///
 /// This class has been partially implemented by Umut Sen (umutsen@sabanciuniv.edu).
 ///
@@ -87,6 +91,18 @@ public:
 
 	/// Function to set the mPriority vector
 	void setPriority(priority* pPriority);
+
+	/// Function to remove a path from the trie
+	void removePath(TrieNode* pLeafNode);
+
+	/// Function to remove all nodes that do not belong to a given set of paths
+	int pruneTrie(set<TrieNode*> *pLeafNodes);
+
+	/// Function to get mNoNodes
+	int getNoNodes();
+
+	/// Function to return the number of bytes allocated for a node
+	static long getNodeSize();
 	
 private:
 
@@ -96,6 +112,10 @@ private:
 	/// Function that returns the priority of a node
 	priority getNodePriority(TrieNode* pNode);
 
+	/// Function to remove the nodes below a node that do not belong to a given set of paths
+	bool pruneSubTrie(TrieNode* pNode, set<TrieNode*> *pLeafNodes);
+
 	TrieNode* mRoot;		///< pointer to the root node
 	priority* mPriority;	///< pointer to the array holding priorities of dictionary elements
+	int mNoNodes;			///< number of nodes in the trie (excluding the root)
 };
@@ -277,6 +277,70 @@ float computeInnerProd( float* pSrc1, float* pSrc2, int pSize )
 	return val;
 }
 
+// Function to compute inner-products of all vectors in an array with all vectors in another array
+/// This function computes pDst[j][i] = <pSrc1[i], pSrc2[j]>, i.e. the matrix product pSrc1' x pSrc2, where the vectors
+/// are the columns of the matrices. The vectors of pSrc1 are processed in blocks that fit into the cache while all vectors
+/// of pSrc2 pass over them, and the inner products are computed 4 x 4 at a time, so that each loaded element is used four times.
+/// The blocks write disjoint entries of the result vectors, so they are distributed over threads when compiled with OpenMP.
+/// @param pSrc1 pointer to the first vector array (e.g. the dictionary atoms)
+/// @param pSrc2 pointer to the second vector array (e.g. the observation vectors)
+/// @param pDst pointer to the result array (pNoVectors2 vectors of length pNoVectors1)
+/// @param pNoVectors1 number of vectors in pSrc1
+/// @param pNoVectors2 number of vectors in pSrc2
+/// @param pSize length of vectors
+void computeInnerProdMatrix( float** pSrc1, float** pSrc2, float** pDst, int pNoVectors1, int pNoVectors2, int pSize )
+{
+	const int blockSize = 64;	// 64 vectors of pSrc1 (64 kB for pSize = 256, held in L2 while pSrc2 streams through L1)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+	for(int i0 = 0; i0<pNoVectors1; i0+=blockSize)
+	{
+		int i1 = min(i0+blockSize, pNoVectors1);
+		int j = 0;
+		for(; j+4<=pNoVectors2; j+=4)
+		{
+			float *b0 = pSrc2[j], *b1 = pSrc2[j+1], *b2 = pSrc2[j+2], *b3 = pSrc2[j+3];
+			int i = i0;
+			for(; i+4<=i1; i+=4)
+			{
+				float *a0 = pSrc1[i], *a1 = pSrc1[i+1], *a2 = pSrc1[i+2], *a3 = pSrc1[i+3];
+				float c00 = 0, c01 = 0, c02 = 0, c03 = 0;
+				float c10 = 0, c11 = 0, c12 = 0, c13 = 0;
+				float c20 = 0, c21 = 0, c22 = 0, c23 = 0;
+				float c30 = 0, c31 = 0, c32 = 0, c33 = 0;
+				for(int k = 0; k<pSize; k++)
+				{
+					float x0 = a0[k], x1 = a1[k], x2 = a2[k], x3 = a3[k];
+					float y0 = b0[k], y1 = b1[k], y2 = b2[k], y3 = b3[k];
+					c00 += x0*y0; c01 += x0*y1; c02 += x0*y2; c03 += x0*y3;
+					c10 += x1*y0; c11 += x1*y1; c12 += x1*y2; c13 += x1*y3;
+					c20 += x2*y0; c21 += x2*y1; c22 += x2*y2; c23 += x2*y3;
+					c30 += x3*y0; c31 += x3*y1; c32 += x3*y2; c33 += x3*y3;
+				}
+				pDst[j][i] = c00; pDst[j+1][i] = c01; pDst[j+2][i] = c02; pDst[j+3][i] = c03;
+				pDst[j][i+1] = c10; pDst[j+1][i+1] = c11; pDst[j+2][i+1] = c12; pDst[j+3][i+1] = c13;
+				pDst[j][i+2] = c20; pDst[j+1][i+2] = c21; pDst[j+2][i+2] = c22; pDst[j+3][i+2] = c23;
+				pDst[j][i+3] = c30; pDst[j+1][i+3] = c31; pDst[j+2][i+3] = c32; pDst[j+3][i+3] = c33;
+			}
+			// remaining vectors of the block
+			for(; i<i1; i++)
+			{
+				pDst[j][i] = computeInnerProd(pSrc1[i], b0, pSize);
+				pDst[j+1][i] = computeInnerProd(pSrc1[i], b1, pSize);
+				pDst[j+2][i] = computeInnerProd(pSrc1[i], b2, pSize);
+				pDst[j+3][i] = computeInnerProd(pSrc1[i], b3, pSize);
+			}
+		}
+		// remaining vectors of pSrc2
+		for(; j<pNoVectors2; j++)
+		{
+			for(int i = i0; i<i1; i++)
+				pDst[j][i] = computeInnerProd(pSrc1[i], pSrc2[j], pSize);
+		}
+	}
+}
+
 /// Function to normalize a vector (in place)
 /// This function normalizes pSrcDst (such that its \f$l_2\f$ norm is 1)
 /// and stores the normalized vector in pSrcDst.
@@ -381,6 +445,25 @@ float computeMean( float *pSrc, int pSize )
 	return sumVector(pSrc,pSize)/(float)pSize;
 }
 
+// Function to compute a percentile of a vector
+/// This function returns the smallest element of pSrc that is not smaller than pPercentile of its elements
+/// (nearest-rank method). pSrc is not altered.
+/// @param pSrc pointer to the source vector
+/// @param pSize length of pSrc
+/// @param pPercentile percentile in [0,1] (1 for the maximum)
+/// @return pPercentile percentile of pSrc
+float computePercentile( float *pSrc, int pSize, float pPercentile )
+{
+	vector<float> sorted(pSrc, pSrc+pSize);
+	int rank = (int)ceil(pPercentile*pSize)-1;
+	if(rank<0)
+		rank = 0;
+	if(rank>pSize-1)
+		rank = pSize-1;
+	nth_element(sorted.begin(), sorted.begin()+rank, sorted.end());
+	return sorted[rank];
+}
+
 // Function to sum elements of a vector
 /// This function returns the sum of elements of pSrc.
 /// @param pSrc pointer to the source vector
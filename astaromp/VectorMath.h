@@ -35,6 +35,7 @@ karahanoglu@sabanciuniv.edu,  burak.karahanoglu@gmail.com
 
 #include <vector>
 #include <map>
+#include <algorithm>
 #include <math.h>
 
 #include <string.h>
@@ -104,12 +105,18 @@ void deleteIntMatrix( int** pMatrix, int pCols );
 /// Function to compute inner-product of two vectors
 float computeInnerProd(float* pSrc1, float* pSrc2, int pSize);
 
+/// Function to compute inner-products of all vectors in an array with all vectors in another array
+void computeInnerProdMatrix(float** pSrc1, float** pSrc2, float** pDst, int pNoVectors1, int pNoVectors2, int pSize);
+
 /// Function to solve a linear system with upper triangular (UT) system matrix
 void linsolve_UT(float **pA, float *pb, float *px, int pNoCols);
 
 /// Function to compute mean of a vector
 float computeMean(float *pSrc, int pSize);
 
+/// Function to compute a percentile of a vector
+float computePercentile(float *pSrc, int pSize, float pPercentile);
+
 /// Function to sum elements of a vector
 float sumVector(float *pSrc, int pSize);
 
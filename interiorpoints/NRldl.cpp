@@ -1,14 +1,17 @@
-NRldl::NRldl(NRsparseMat &adat) : n(adat.ncols), nz(adat.nvals),
+NRldl::NRldl(NRsparseMat &adat) : n(adat.ncols), nz(adat.nvals), verbose(true),
+supernodal(NRLDL_SUPERNODAL), mixed(NRLDL_MIXED), single(false), nsuper(0), maxnr(0),
+nthreads(1), nskip(0), nrefine(0), nfallback(0), ptol(0.0), dmax(0.0),
 Ap(&adat.col_ptr[0]), Ai(&adat.row_ind[0]), Ax(&adat.val[0]),
 PP(n),PPinv(n),PPattern(n),LLnz(n),LLp(n+1),PParent(n),FFlag(n),
-YY(n),DD(n),Y(&YY[0]),D(&DD[0]),P(&PP[0]),Pinv(&PPinv[0]),
+YY(n),DD(n),RR(n),DY(n),Y(&YY[0]),D(&DD[0]),P(&PP[0]),Pinv(&PPinv[0]),
 Pattern(&PPattern[0]),Lnz(&LLnz[0]),Lp(&LLp[0]),Parent(&PParent[0]),
 Flag(&FFlag[0]) {}
 
 void NRldl::order() {
 	if (amd_order (n, Ap, Ai, P, (Doub *) NULL, Info) != AMD_OK)
 		throw("call to AMD failed");
-	amd_control ((Doub *) NULL);
+	if (verbose)
+		amd_control ((Doub *) NULL);
 	//amd_info (Info);
 	ldl_symbolic (n, Ap, Ai, Lp, Parent, Lnz, Flag, P, Pinv);
 	lnz = Lp [n];
@@ -16,29 +19,296 @@ void NRldl::order() {
 	Doub flops = 0 ;
 	for (Int j = 0 ; j < n ; j++)
 		flops += ((Doub) Lnz [j]) * (Lnz [j] + 2) ;
-	cout << "Nz in L: " << lnz << " Flop count: " << flops << endl;
+	if (verbose)
+		cout << "Nz in L: " << lnz << " Flop count: " << flops << endl;
 	/* -------------------------------------------------------------- */
 	/* allocate remainder of L, of size lnz */
 	/* -------------------------------------------------------------- */
-	LLi=new VecInt(lnz);
-	LLx=new VecDoub(lnz);
-	Li=&(*LLi)[0];
-	Lx=&(*LLx)[0];
+	LLi.resize(lnz);
+	LLx.resize(lnz);
+	Li=&LLi[0];
+	Lx=&LLx[0];
+	if (supernodal) {
+		supersymbolic();
+		if (verbose)
+			cout << "Supernodes: " << nsuper << ", largest " << maxnr << " rows" << endl;
+	}
+}
+
+void NRldl::supersymbolic() {
+	Int i,j,k,p,s,t,last,nr,nc;
+	/* structure of L by columns, each sorted, as ldl_numeric finds it row by row */
+	VecInt cnt(n,0);
+	for (k=0;k<n;k++) {
+		Flag[k]=k;
+		Int kk=P[k];
+		for (p=Ap[kk];p<Ap[kk+1];p++) {
+			i=Pinv[Ai[p]];
+			if (i < k)
+				for (;Flag[i] != k;i=Parent[i]) {
+					Li[Lp[i]+cnt[i]++]=k;
+					Flag[i]=k;
+				}
+		}
+	}
+	/* column j joins the supernode of j-1 if its structure is that of j-1 without j */
+	Smap.resize(n);
+	vector<Int> first;
+	for (j=0;j<n;j++) {
+		if (j == 0 || Parent[j-1] != j || Lnz[j-1] != Lnz[j]+1)
+			first.push_back(j);
+		Smap[j]=first.size()-1;
+	}
+	nsuper=first.size();
+	first.push_back(n);
+	Sup.resize(nsuper+1);
+	Srp.resize(nsuper+1);
+	Sxp.resize(nsuper+1);
+	Srp[0]=Sxp[0]=0;
+	Doub sx=0.0;
+	maxnr=0;
+	for (s=0;s<nsuper;s++) {
+		Sup[s]=first[s];
+		nc=first[s+1]-first[s];
+		nr=nc+Lnz[first[s+1]-1];
+		Srp[s+1]=Srp[s]+nr;
+		Sxp[s+1]=Sxp[s]+nr*nc;
+		sx+=(Doub)nr*nc;
+		maxnr=MAX(maxnr,nr);
+	}
+	Sup[nsuper]=n;
+	if (sx > numeric_limits<Int>::max()) {
+		supernodal=false;
+		return;
+	}
+	/* rows of a supernode: its own columns and the structure of its last column */
+	Srow.resize(Srp[nsuper]);
+	for (s=0;s<nsuper;s++) {
+		Int l=Sup[s+1]-1;
+		p=Srp[s];
+		for (j=Sup[s];j<=l;j++)
+			Srow[p++]=j;
+		for (k=Lp[l];k<Lp[l]+Lnz[l];k++)
+			Srow[p++]=Li[k];
+	}
+	/* supernodal elimination tree */
+	Spar.resize(nsuper);
+	Schp.assign(nsuper+1,0);
+	for (s=0;s<nsuper;s++) {
+		Int l=Sup[s+1]-1;
+		Spar[s]=(Parent[l] < 0 ? -1 : Smap[Parent[l]]);
+		if (Spar[s] >= 0)
+			Schp[Spar[s]+1]++;
+	}
+	for (s=0;s<nsuper;s++)
+		Schp[s+1]+=Schp[s];
+	Sch.resize(MAX(Schp[nsuper],1));
+	VecInt next(nsuper+1);
+	for (s=0;s<nsuper;s++)
+		next[s]=Schp[s];
+	for (s=0;s<nsuper;s++)
+		if (Spar[s] >= 0)
+			Sch[next[Spar[s]]++]=s;
+	/* for every supernode, the supernodes that update it, in increasing order */
+	Updp.assign(nsuper+1,0);
+	for (Int pass=0;pass<2;pass++) {
+		for (t=0;t<nsuper;t++) {
+			last=-1;
+			nc=Sup[t+1]-Sup[t];
+			for (p=Srp[t]+nc;p<Srp[t+1];p++) {
+				s=Smap[Srow[p]];
+				if (s == last)
+					continue;
+				last=s;
+				if (pass == 0)
+					Updp[s+1]++;
+				else
+					Upd[next[s]++]=t;
+			}
+		}
+		if (pass == 0) {
+			for (s=0;s<nsuper;s++)
+				Updp[s+1]+=Updp[s];
+			Upd.resize(MAX(Updp[nsuper],1));
+			for (s=0;s<nsuper;s++)
+				next[s]=Updp[s];
+		}
+	}
+	Sx.resize(Sxp[nsuper]);
+#ifdef _OPENMP
+	nthreads=omp_get_max_threads();
+#endif
+	Rmap.resize(nthreads*n);
+	Swork.resize(nthreads*2*maxnr);
+}
+
+template <class T>
+void NRldl::supernode(Int s, Int *map, T *work, T *sx, T *d) {
+	Int c,k,p,q,f=Sup[s],l=Sup[s+1]-1,nc=l-f+1,nr=Srp[s+1]-Srp[s];
+	const Int *rows=&Srow[Srp[s]];
+	T *x=sx+Sxp[s], *tmp=work, *tk=work+maxnr, t;
+	const T big=T(MIN(1.0e64,sqrt(Doub(numeric_limits<T>::max()))));
+	for (p=0;p<nr;p++)
+		map[rows[p]]=p;
+	for (p=0;p<nr*nc;p++)
+		x[p]=0.0;
+	/* lower triangle of the columns f..l of PAP' */
+	for (c=0;c<nc;c++) {
+		Int j=f+c, kk=P[j];
+		for (q=Ap[kk];q<Ap[kk+1];q++) {
+			Int r=Pinv[Ai[q]];
+			if (r >= j)
+				x[c*nr+map[r]]+=Ax[q];
+		}
+	}
+	/* updates from the supernodes below, one target column at a time */
+	for (Int u=Updp[s];u<Updp[s+1];u++) {
+		Int tt=Upd[u], ft=Sup[tt], nct=Sup[tt+1]-ft, nrt=Srp[tt+1]-Srp[tt];
+		const Int *rt=&Srow[Srp[tt]];
+		const T *xt=sx+Sxp[tt];
+		Int p1=nct;
+		while (rt[p1] < f)
+			p1++;
+		for (q=p1;q<nrt && rt[q] <= l;q++) {
+			Int m=nrt-q;
+			for (k=0;k<nct;k++)
+				tk[k]=xt[k*nrt+q]*d[ft+k];
+			for (p=0;p<m;p++)
+				tmp[p]=0.0;
+			for (k=0;k+4<=nct;k+=4) {
+				const T *l0=xt+k*nrt+q, *l1=l0+nrt, *l2=l1+nrt, *l3=l2+nrt;
+				T t0=tk[k], t1=tk[k+1], t2=tk[k+2], t3=tk[k+3];
+				for (p=0;p<m;p++)
+					tmp[p]+=l0[p]*t0+l1[p]*t1+l2[p]*t2+l3[p]*t3;
+			}
+			for (;k<nct;k++) {
+				const T *lk=xt+k*nrt+q;
+				t=tk[k];
+				for (p=0;p<m;p++)
+					tmp[p]+=lk[p]*t;
+			}
+			T *xc=x+(rt[q]-f)*nr;
+			for (p=0;p<m;p++)
+				xc[map[rt[q+p]]]-=tmp[p];
+		}
+	}
+	/* dense L.D.L^T of the supernode */
+	for (c=0;c<nc;c++) {
+		T *xc=x+c*nr;
+		for (k=0;k+4<=c;k+=4) {		// four columns at a time: one pass over xc
+			const T *x0=x+k*nr, *x1=x0+nr, *x2=x1+nr, *x3=x2+nr;
+			T t0=x0[c]*d[f+k], t1=x1[c]*d[f+k+1], t2=x2[c]*d[f+k+2], t3=x3[c]*d[f+k+3];
+			for (p=c;p<nr;p++)
+				xc[p]-=x0[p]*t0+x1[p]*t1+x2[p]*t2+x3[p]*t3;
+		}
+		for (;k<c;k++) {
+			const T *xk=x+k*nr;
+			t=xk[c]*d[f+k];
+			for (p=c;p<nr;p++)
+				xc[p]-=xk[p]*t;
+		}
+		t=xc[c];
+		if (abs(t) <= ptol) {
+			t=big;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+			nskip++;
+		}
+		D[f+c]=d[f+c]=t;
+		t=T(1)/t;
+		for (p=c+1;p<nr;p++)
+			xc[p]*=t;
+		Doub *lx=Lx+Lp[f+c]-(c+1);
+		for (p=c+1;p<nr;p++)
+			lx[p]=xc[p];
+	}
+}
+
+void NRldl::supernode(Int s, Int id) {
+	if (single)
+		supernode(s,&Rmap[id*n],&SworkF[id*2*maxnr],&SxF[0],&DF[0]);
+	else
+		supernode(s,&Rmap[id*n],&Swork[id*2*maxnr],&Sx[0],D);
+}
+
+void NRldl::supertree(Int s) {
+	for (Int c=Schp[s];c<Schp[s+1];c++) {
+		Int ch=Sch[c];
+#ifdef _OPENMP
+#pragma omp task firstprivate(ch)
+#endif
+		supertree(ch);
+	}
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+	Int id=0;
+#ifdef _OPENMP
+	id=omp_get_thread_num();
+#endif
+	supernode(s,id);
 }
 
 void NRldl::factorize() {
+	if (supernodal) {
+		dmax=0.0;
+		for (Int j=0;j<n;j++)
+			for (Int q=Ap[j];q<Ap[j+1];q++)
+				if (Ai[q] == j)
+					dmax=MAX(dmax,abs(Ax[q]));
+		ptol=1.0e-30*dmax;
+		superfactorize(mixed);
+		return;
+	}
 	/* -------------------------------------------------------------- */
 	/* numeric factorization to get Li, Lx, and D */
 	/* -------------------------------------------------------------- */
+	single=false;
 	Int dd = ldl_numeric (n, Ap, Ai, Ax, Lp, Parent, Lnz, Li, Lx, D,
 						  Y, Flag, Pattern, P, Pinv) ;
 	if (dd != n)
 		throw("Factorization failed since diagonal is zero.");
 }
 
+void NRldl::superfactorize(Bool sp) {
+	single=sp;
+	if (single && SxF.size() != Sx.size()) {
+		SxF.resize(Sx.size());
+		SworkF.resize(Swork.size());
+		DF.resize(n);
+	}
+	nskip=0;
+	if (nthreads > 1 && nsuper > 1) {
+#ifdef _OPENMP
+#pragma omp parallel
+#pragma omp single
+#endif
+		for (Int s=0;s<nsuper;s++)
+			if (Spar[s] < 0) {
+#ifdef _OPENMP
+#pragma omp task firstprivate(s)
+#endif
+				supertree(s);
+			}
+	}
+	else
+		for (Int s=0;s<nsuper;s++)
+			supernode(s,0);
+}
+
 void NRldl::solve(VecDoub_O &y,VecDoub &rhs) {
-	B=&rhs[0];
-	X=&y[0];
+	ldlsolve(&y[0],&rhs[0]);
+	if (single && !refine(y,rhs)) {		/* refinement stalled: factor in double */
+		nfallback++;
+		superfactorize(false);
+		ldlsolve(&y[0],&rhs[0]);
+	}
+}
+
+void NRldl::ldlsolve(Doub *x, Doub *b) {
+	B=b;
+	X=x;
 	/* solve Ax=b */
 	/* the factorization is LDL' = PAP' */
 	ldl_perm (n, Y, B, P) ;             /* y = Pb */
@@ -48,7 +318,218 @@ void NRldl::solve(VecDoub_O &y,VecDoub &rhs) {
 	ldl_permt (n, X, Y, P) ;            /* x = P'y */
 }
 
+Bool NRldl::refine(VecDoub_O &y, VecDoub &rhs) {
+	/* iterative refinement of the solution y of a single precision factorization: the
+	   residual in double with the original matrix, the correction with the factors.
+	   False if the residual stops shrinking before it is down to the level of a double
+	   precision solve */
+	Int i,j,q,it;
+	Doub rn,ym,bm=0.0,rold=numeric_limits<Doub>::max();
+	for (i=0;i<n;i++)
+		bm=MAX(bm,abs(rhs[i]));
+	for (it=0;;it++) {
+		for (i=0;i<n;i++)
+			RR[i]=rhs[i];
+		for (j=0;j<n;j++) {
+			Doub yj=y[j];
+			for (q=Ap[j];q<Ap[j+1];q++)
+				RR[Ai[q]]-=Ax[q]*yj;
+		}
+		rn=ym=0.0;
+		for (i=0;i<n;i++) {
+			rn=MAX(rn,abs(RR[i]));
+			ym=MAX(ym,abs(y[i]));
+		}
+		if (rn <= NRLDL_RTOL*(dmax*ym+bm))
+			return true;
+		if (it == NRLDL_MAXREFINE || !(rn <= 0.5*rold))
+			return false;
+		rold=rn;
+		ldlsolve(&DY[0],&RR[0]);
+		for (i=0;i<n;i++)
+			y[i]+=DY[i];
+		nrefine++;
+	}
+}
+
+void NRldl::solve(MatDoub_O &y, MatDoub_I &rhs) {
+	blocksolve(y,rhs);
+	if (single && !refine(y,rhs)) {
+		nfallback++;
+		superfactorize(false);
+		blocksolve(y,rhs);
+	}
+}
+
+Bool NRldl::refine(MatDoub_O &y, MatDoub_I &rhs) {
+	/* refine() for the columns of y together, judged by the largest residual */
+	Int i,j,q,r,it,k=rhs.ncols();
+	Doub rn,ym,bm=0.0,rold=numeric_limits<Doub>::max();
+	if (RB.nrows() != n || RB.ncols() != k)
+		RB.resize(n,k);
+	for (i=0;i<n;i++)
+		for (r=0;r<k;r++)
+			bm=MAX(bm,abs(rhs[i][r]));
+	for (it=0;;it++) {
+		for (i=0;i<n;i++)
+			for (r=0;r<k;r++)
+				RB[i][r]=rhs[i][r];
+		for (j=0;j<n;j++) {
+			const Doub *yj=y[j];
+			for (q=Ap[j];q<Ap[j+1];q++) {
+				Doub *w=RB[Ai[q]], a=Ax[q];
+				for (r=0;r<k;r++)
+					w[r]-=a*yj[r];
+			}
+		}
+		rn=ym=0.0;
+		for (i=0;i<n;i++)
+			for (r=0;r<k;r++) {
+				rn=MAX(rn,abs(RB[i][r]));
+				ym=MAX(ym,abs(y[i][r]));
+			}
+		if (rn <= NRLDL_RTOL*(dmax*ym+bm))
+			return true;
+		if (it == NRLDL_MAXREFINE || !(rn <= 0.5*rold))
+			return false;
+		rold=rn;
+		blocksolve(RB,RB);
+		for (i=0;i<n;i++)
+			for (r=0;r<k;r++)
+				y[i][r]+=RB[i][r];
+		nrefine++;
+	}
+}
+
+void NRldl::blocksolve(MatDoub_O &y, MatDoub_I &rhs) {
+	/* rhs is copied into YB before y is written, so y and rhs may be the same */
+	Int i,j,p,r,k=rhs.ncols();
+	if (YB.nrows() != n || YB.ncols() != k)
+		YB.resize(n,k);
+	for (j=0;j<n;j++) {				/* Y = P B */
+		const Doub *b=rhs[P[j]];
+		Doub *w=YB[j];
+		for (r=0;r<k;r++)
+			w[r]=b[r];
+	}
+	if (supernodal && !single)
+		supersolve(k);
+	else {
+		for (j=0;j<n;j++) {			/* Y = L\Y */
+			const Doub *w=YB[j];
+			for (p=Lp[j];p<Lp[j+1];p++) {
+				Doub *wi=YB[Li[p]], l=Lx[p];
+				for (r=0;r<k;r++)
+					wi[r]-=l*w[r];
+			}
+		}
+		for (j=0;j<n;j++) {			/* Y = D\Y */
+			Doub *w=YB[j], d=D[j];
+			for (r=0;r<k;r++)
+				w[r]/=d;
+		}
+		for (j=n-1;j>=0;j--) {			/* Y = L'\Y */
+			Doub *w=YB[j];
+			for (p=Lp[j];p<Lp[j+1];p++) {
+				const Doub *wi=YB[Li[p]];
+				Doub l=Lx[p];
+				for (r=0;r<k;r++)
+					w[r]-=l*wi[r];
+			}
+		}
+	}
+	for (i=0;i<n;i++) {				/* X = P'Y */
+		const Doub *w=YB[i];
+		Doub *x=y[P[i]];
+		for (r=0;r<k;r++)
+			x[r]=w[r];
+	}
+}
+
+void NRldl::supersolve(Int k) {
+	/* L, D and L' solves of YB with the dense blocks of the supernodes: the columns
+	   of a supernode are taken four at a time, so that every row of YB below them is
+	   loaded and stored once for four columns of L */
+	Int s,c,c0,c2,cb,p,r;
+	for (s=0;s<nsuper;s++) {			/* Y = L\Y */
+		Int f=Sup[s], nc=Sup[s+1]-f, nr=Srp[s+1]-Srp[s];
+		const Int *rows=&Srow[Srp[s]];
+		const Doub *x=&Sx[Sxp[s]];
+		for (c0=0;c0<nc;c0+=4) {
+			cb=MIN(Int(4),nc-c0);
+			for (c=c0;c<c0+cb;c++)
+				for (c2=c+1;c2<c0+cb;c2++) {
+					Doub *w=YB[f+c2], l=x[c*nr+c2];
+					const Doub *yc=YB[f+c];
+					for (r=0;r<k;r++)
+						w[r]-=l*yc[r];
+				}
+			if (cb == 4) {
+				const Doub *x0=x+c0*nr, *x1=x0+nr, *x2=x1+nr, *x3=x2+nr;
+				const Doub *y0=YB[f+c0], *y1=YB[f+c0+1], *y2=YB[f+c0+2], *y3=YB[f+c0+3];
+				for (p=c0+4;p<nr;p++) {
+					Doub *w=YB[rows[p]], a0=x0[p], a1=x1[p], a2=x2[p], a3=x3[p];
+					for (r=0;r<k;r++)
+						w[r]-=a0*y0[r]+a1*y1[r]+a2*y2[r]+a3*y3[r];
+				}
+			}
+			else
+				for (c=c0;c<c0+cb;c++) {
+					const Doub *yc=YB[f+c];
+					for (p=c0+cb;p<nr;p++) {
+						Doub *w=YB[rows[p]], l=x[c*nr+p];
+						for (r=0;r<k;r++)
+							w[r]-=l*yc[r];
+					}
+				}
+		}
+	}
+	for (Int j=0;j<n;j++) {				/* Y = D\Y */
+		Doub *w=YB[j], d=D[j];
+		for (r=0;r<k;r++)
+			w[r]/=d;
+	}
+	for (s=nsuper-1;s>=0;s--) {			/* Y = L'\Y */
+		Int f=Sup[s], nc=Sup[s+1]-f, nr=Srp[s+1]-Srp[s];
+		const Int *rows=&Srow[Srp[s]];
+		const Doub *x=&Sx[Sxp[s]];
+		for (c0=(nc-1)/4*4;c0>=0;c0-=4) {
+			cb=MIN(Int(4),nc-c0);
+			if (cb == 4) {
+				const Doub *x0=x+c0*nr, *x1=x0+nr, *x2=x1+nr, *x3=x2+nr;
+				Doub *w0=YB[f+c0], *w1=YB[f+c0+1], *w2=YB[f+c0+2], *w3=YB[f+c0+3];
+				for (p=c0+4;p<nr;p++) {
+					const Doub *yi=YB[rows[p]];
+					Doub a0=x0[p], a1=x1[p], a2=x2[p], a3=x3[p];
+					for (r=0;r<k;r++) {
+						Doub t=yi[r];
+						w0[r]-=a0*t;
+						w1[r]-=a1*t;
+						w2[r]-=a2*t;
+						w3[r]-=a3*t;
+					}
+				}
+			}
+			else
+				for (c=c0;c<c0+cb;c++) {
+					Doub *w=YB[f+c];
+					for (p=c0+cb;p<nr;p++) {
+						const Doub *yi=YB[rows[p]];
+						Doub l=x[c*nr+p];
+						for (r=0;r<k;r++)
+							w[r]-=l*yi[r];
+					}
+				}
+			for (c=c0+cb-1;c>=c0;c--)
+				for (c2=c+1;c2<c0+cb;c2++) {
+					Doub *w=YB[f+c], l=x[c*nr+c2];
+					const Doub *yc=YB[f+c2];
+					for (r=0;r<k;r++)
+						w[r]-=l*yc[r];
+				}
+		}
+	}
+}
+
 NRldl::~NRldl() {
-	delete LLx;
-	delete LLi;
 }
\ No newline at end of file
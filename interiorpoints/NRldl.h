@@ -3,12 +3,57 @@ extern "C" {
 	#include "amd.h"
 }
 
+#ifndef NRLDL_SUPERNODAL
+#define NRLDL_SUPERNODAL 1		// default of NRldl::supernodal
+#endif
+
+#ifndef NRLDL_MIXED
+#define NRLDL_MIXED 0			// default of NRldl::mixed
+#endif
+
+#ifndef NRLDL_RTOL
+#define NRLDL_RTOL 1.0e-14		// relative residual at which refinement stops
+#endif
+
+#ifndef NRLDL_MAXREFINE
+#define NRLDL_MAXREFINE 10		// refinement steps before falling back to double
+#endif
+
 struct NRldl {
 // Interface between Numerical Recipes routine intpt and the required packages LDL and AMD
+// With supernodal set (before order()), the numeric factorization is not done by
+// ldl_numeric, one row of L at a time, but by supernodes: runs of columns of L with the
+// same structure below the diagonal, found from the elimination tree of ldl_symbolic.
+// A supernode is held as a dense column major block, receives the updates of the
+// supernodes below it in the tree as dense column operations, and is factored by dense
+// L.D.L^T. Independent subtrees are factored in parallel when compiled with OpenMP. L
+// and D are written back to Lp/Li/Lx and D, so solve() is the same for both. Near the
+// optimum of a degenerate LP a pivot can cancel to zero; the supernodal factorization
+// then replaces it by a huge value, as DenseADAT does, and counts it in nskip, where
+// ldl_numeric would throw.
+// With mixed set as well, the supernodes are factored in single precision, which halves
+// the memory traffic of the factorization and doubles the width of its vector
+// operations, and solve() recovers double precision by iterative refinement against
+// the original matrix. If the refinement stalls, as it does once A.D.A^T is too ill
+// conditioned for single precision, the matrix is factored again in double precision
+// and the solve repeated; that factorization then serves until the next factorize().
 	Doub Info [AMD_INFO];
 	Int lnz,n,nz;
-	VecInt PP,PPinv,PPattern,LLnz,LLp,PParent,FFlag,*LLi;
-	VecDoub YY,DD,*LLx;
+	Bool verbose;				// report the size of L in order()
+	Bool supernodal;			// numeric factorization by supernodes
+	Bool mixed;				// single precision supernodes and refinement
+	Bool single;				// the current factorization is single precision
+	Int nsuper,maxnr,nthreads;
+	Int nskip;				// pivots replaced in the last supernodal factorization
+	Int nrefine,nfallback;			// refinement steps and fallbacks to double, in total
+	Doub ptol;				// pivots below ptol in magnitude are replaced
+	Doub dmax;				// largest diagonal entry of the matrix
+	VecInt Sup,Smap,Srp,Srow,Sxp,Spar,Schp,Sch,Updp,Upd,Rmap;
+	VecDoub Sx,Swork;
+	NRvector<float> SxF,SworkF,DF;		// single precision Sx, Swork and D
+	MatDoub YB,RB;				// workspace of the solve with several right-hand sides
+	VecInt PP,PPinv,PPattern,LLnz,LLp,PParent,FFlag,LLi;
+	VecDoub YY,DD,RR,DY,LLx;
 	Doub *Ax, *Lx, *B, *D, *X, *Y;
 	Int *Ai, *Ap, *Li, *Lp, *P, *Pinv, *Flag,*Pattern, *Lnz, *Parent;
 	NRldl(NRsparseMat &adat);
@@ -17,7 +62,28 @@ struct NRldl {
 	// AMD ordering and LDL symbolic factorization. Only neds nonzero pattern of adat, not actual values
 	void factorize();
 	// Numerical factorization of matrix 
+	void supersymbolic();
+	// Supernodes, structure of L and the lists of updates, after ldl_symbolic
+	void superfactorize(Bool sp);
+	// Supernodal numerical factorization, in single precision if sp
+	template <class T> void supernode(Int s, Int *map, T *work, T *sx, T *d);
+	// Numerical factorization of supernode s, in the precision of T
+	void supernode(Int s, Int id);
+	// The same, in the precision of the factorization, with the workspace of thread id
+	void supertree(Int s);
+	// Factorization of the subtree of supernode s
 	void solve(VecDoub_O &y,VecDoub &rhs);
 	// Solves for y given rhs. Can be invoked multiple times after a single call to factorize
+	void ldlsolve(Doub *x, Doub *b);
+	// The permutations and triangular solves of solve()
+	Bool refine(VecDoub_O &y, VecDoub &rhs);
+	// Iterative refinement of y after a single precision factorization, false if it stalls
+	void solve(MatDoub_O &y, MatDoub_I &rhs);
+	// Solves for the columns of y given those of rhs (n x k), all k together: every entry
+	// of L is loaded once per block instead of once per right-hand side
+	void blocksolve(MatDoub_O &y, MatDoub_I &rhs);
+	Bool refine(MatDoub_O &y, MatDoub_I &rhs);
+	void supersolve(Int k);
+	// The triangular and diagonal solves of solve() with the blocks of the supernodes
 	~NRldl();
 };
\ No newline at end of file
@@ -0,0 +1,100 @@
+/*
+ Begin adatbench.cpp
+ */
+/*
+ Timing of ADAT::updateD, the formation of A.D.A^T in every interior point iteration,
+ by the original scatter (updateD_scatter) and by the gather over the precomputed
+ contribution index (updateD), for random A of several sizes and densities. The time of
+ building the index and the largest difference of the results are printed as well.
+ Build with -fopenmp to run the gather on all cores; the index is built here even when
+ ADAT itself would leave it out.
+
+ Usage: adatbench [reps [seed]]   (default 20 1)
+ */
+#include "nr3.h"
+#include "sparse.h"
+
+void init_A(Int M, Int N, Doub dens, NRsparseMat &a)
+// Random A in compressed column storage, every entry nonzero with probability dens
+{
+	Int i,j,nz=0;
+	vector<Int> ri;
+	vector<Doub> v;
+	VecInt cp(N+1);
+	for (j=0;j<N;j++) {
+		cp[j]=nz;
+		for (i=0;i<M;i++)
+			if ((Doub)rand()/RAND_MAX < dens) {
+				ri.push_back(i);
+				v.push_back((Doub)rand()/RAND_MAX);
+				nz++;
+			}
+	}
+	cp[N]=nz;
+	a=NRsparseMat(M,N,nz);
+	for (j=0;j<=N;j++) a.col_ptr[j]=cp[j];
+	for (i=0;i<nz;i++) {
+		a.row_ind[i]=ri[i];
+		a.val[i]=v[i];
+	}
+}
+
+Doub wtime()
+// Wall clock seconds; clock() would add up the time of all threads
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec+1.0e-9*ts.tv_nsec;
+}
+
+Int main(int argc, char **argv) {
+
+	const Int NCASES=6;
+	const Doub cases[NCASES][3]={{80,256,1.0},{128,512,1.0},{256,1024,0.1},
+		{512,2048,0.05},{1024,4096,0.02},{2048,8192,0.01}};	// M, N, density
+	Int i,j,r,c,M,N,reps=20;
+	Doub tStart,t_index,t_scatter,t_gather,diff;
+
+	if (argc > 1) reps=atoi(argv[1]);
+	srand(argc > 2 ? atoi(argv[2]) : 1);
+
+	printf("Running program InteriorPoints A.D.A^T benchmark, s per updateD\n\n");
+	printf("     M     N  dens |   nnz(ADAT)    products |      index     scatter      gather | max diff\n");
+	for (c=0;c<NCASES;c++) {
+		M=(Int)cases[c][0];
+		N=(Int)cases[c][1];
+		NRsparseMat A;
+		init_A(M,N,cases[c][2],A);
+		NRsparseMat At=A.transpose();
+		VecDoub D(N);
+		for (j=0;j<N;j++) D[j]=exp(10.0*((Doub)rand()/RAND_MAX-0.5));
+		ADAT adat(A,At);
+		tStart=wtime();
+		if (adat.cptr.size() == 0)
+			adat.index();
+		t_index=wtime()-tStart;
+		NRsparseMat &S=adat.ref();
+		Int nz=S.col_ptr[M];
+
+		tStart=wtime();
+		for (r=0;r<reps;r++)
+			adat.updateD_scatter(D);
+		t_scatter=(wtime()-tStart)/reps;
+		VecDoub v0(nz);
+		for (i=0;i<nz;i++) v0[i]=S.val[i];
+
+		tStart=wtime();
+		for (r=0;r<reps;r++)
+			adat.updateD(D);
+		t_gather=(wtime()-tStart)/reps;
+		diff=0.0;
+		for (i=0;i<nz;i++) diff=MAX(diff,abs(S.val[i]-v0[i]));
+
+		printf("  %4d  %4d  %4.2f | %11d %11d | %10.6f  %10.6f  %10.6f | %8.1e\n", M,N,cases[c][2],
+			nz,adat.cptr.size() ? adat.cptr[nz] : 0,t_index,t_scatter,t_gather,diff);
+	}
+	printf("\n");
+	return 0;
+}
+
+//end of file adatbench.cpp
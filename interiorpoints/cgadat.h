@@ -0,0 +1,106 @@
+struct CGADAT {
+// Matrix-free alternative to ADAT and NRldl for the normal equations A.D.A^T dy = rhs of
+// intpt, for problems where A.D.A^T is too large to form or to factor. The matrix is
+// only ever applied, as A.(D.(A^T p)) with the products of a LinOp, and the equations
+// are solved by conjugate gradients preconditioned with the diagonal of A.D.A^T (Jacobi),
+// which the LinOp supplies once per updateD. The iteration stops when the residual has
+// dropped to tol times the norm of rhs or after maxit steps; near the optimum, where
+// A.D.A^T is ill conditioned, it may stop on maxit and leave an inexact direction, which
+// is counted in nfail. Storage is a few vectors of length m and n besides the operator.
+	const LinOp &mv;
+	Int m,n;
+	const VecDoub *Dp;		// D of the last updateD()
+	VecDoub pre;			// inverse diagonal of A.D.A^T
+	VecDoub r,z,p,q,tn;
+	Doub tol;			// relative residual at which CG stops
+	Int maxit;			// CG steps per solve at most
+	Int niter,nsolve,nfail;		// CG steps, solves and solves stopped on maxit, in total
+	CGADAT(const LinOp &mv);
+	void updateD(const VecDoub &D);
+	void factorize();
+	void apply(const VecDoub &x, VecDoub &y);
+	void solve(VecDoub_O &y, VecDoub &rhs);
+};
+
+#ifndef CG_TOL
+#define CG_TOL 1.0e-10		// default of CGADAT::tol
+#endif
+
+#ifndef CG_MAXIT
+#define CG_MAXIT 1000		// default of CGADAT::maxit
+#endif
+
+CGADAT::CGADAT(const LinOp &MV) : mv(MV), m(MV.m), n(MV.n), Dp(NULL), pre(m), r(m), z(m),
+	p(m), q(m), tn(n), tol(CG_TOL), maxit(CG_MAXIT), niter(0), nsolve(0), nfail(0) {}
+
+void CGADAT::updateD(const VecDoub &D)
+{
+	Dp=&D;
+}
+
+void CGADAT::factorize()
+// Jacobi preconditioner: the inverse diagonal of A.D.A^T
+{
+	mv.adatdiag(*Dp,pre);
+	for (Int i=0;i<m;i++)
+		pre[i]=(pre[i] > 0.0 ? 1.0/pre[i] : 1.0);
+}
+
+void CGADAT::apply(const VecDoub &x, VecDoub &y)
+// y = A.D.A^T x
+{
+	const VecDoub &D=*Dp;
+	mv.atx(1.0,x,0.0,tn);
+	for (Int j=0;j<n;j++)
+		tn[j]*=D[j];
+	mv.ax(1.0,tn,0.0,y);
+}
+
+void CGADAT::solve(VecDoub_O &y, VecDoub &rhs)
+// Solves A.D.A^T y = rhs by preconditioned conjugate gradients, starting from y = 0
+{
+	Int i,k;
+	Doub alpha,beta,rz,rzold,pq,bnorm=0.0,rnorm;
+	nsolve++;
+	for (i=0;i<m;i++) {
+		y[i]=0.0;
+		r[i]=rhs[i];
+		z[i]=pre[i]*r[i];
+		p[i]=z[i];
+		bnorm+=SQR(r[i]);
+	}
+	bnorm=sqrt(bnorm);
+	if (bnorm == 0.0)
+		return;
+	rz=0.0;
+	for (i=0;i<m;i++)
+		rz+=r[i]*z[i];
+	for (k=0;k<maxit;k++) {
+		apply(p,q);
+		pq=0.0;
+		for (i=0;i<m;i++)
+			pq+=p[i]*q[i];
+		if (pq <= 0.0)			// A.D.A^T singular to working precision
+			break;
+		alpha=rz/pq;
+		rnorm=0.0;
+		for (i=0;i<m;i++) {
+			y[i]+=alpha*p[i];
+			r[i]-=alpha*q[i];
+			rnorm+=SQR(r[i]);
+		}
+		niter++;
+		if (sqrt(rnorm) <= tol*bnorm)
+			return;
+		rzold=rz;
+		rz=0.0;
+		for (i=0;i<m;i++) {
+			z[i]=pre[i]*r[i];
+			rz+=r[i]*z[i];
+		}
+		beta=rz/rzold;
+		for (i=0;i<m;i++)
+			p[i]=z[i]+beta*p[i];
+	}
+	nfail++;
+}
@@ -0,0 +1,118 @@
+/*
+ Begin cgbench.cpp
+ */
+/*
+ The interior point method with the normal equations solved matrix-free by preconditioned
+ conjugate gradients (CGADAT) against the default path, which forms and factors A.D.A^T
+ (densely, DenseADAT, for these Phi). For N from 256 up to nmax, M = N/4, count problems
+ are generated with a dense random Phi and a K-sparse x, K = N/64 (at least 8), and solved
+ with Mehrotra steps by both. Memory is what NRvector and NRmatrix allocate from the
+ construction of the Intpt through its first solve (nralloc_bytes()); it includes the
+ transpose and the dense copy of A, which both keep. Build with -fopenmp to run the
+ products with A on all cores.
+
+ Usage: cgbench [nmax [count [tol [seed]]]]   (default 4096 3 1e-10 1)
+ */
+#include "nr3.h"
+#include "sparse.h"
+#include "NRldl.h"
+#include "intpt.h"
+
+void init_Phi(Int M, Int N, NRsparseMat &a)
+// Dense random Phi in compressed column storage
+{
+	Int i,j;
+	a=NRsparseMat(M,N,M*N);
+	for (j=0;j<N;j++) {
+		a.col_ptr[j]=j*M;
+		for (i=0;i<M;i++) {
+			a.row_ind[j*M+i]=i;
+			a.val[j*M+i]=(Doub)rand()/RAND_MAX;
+		}
+	}
+	a.col_ptr[N]=M*N;
+}
+
+Doub wtime()
+// Wall clock seconds; clock() would add up the time of all threads
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec+1.0e-9*ts.tv_nsec;
+}
+
+Doub snr(VecDoub_I &xact, VecDoub_I &xest)
+{
+	Doub MSE=0.0, Ps=0.0;
+	for (Int i=0;i<xact.size();i++) {
+		MSE+=SQR(xact[i]-xest[i]);
+		Ps+=SQR(xact[i]);
+	}
+	return 10*log10(Ps/MSE);
+}
+
+Int main(int argc, char **argv) {
+
+	Int i,j,l,v,M,N,K,nmax=4096,count=3,its[2],nfail[2];
+	Doub t[2],snrsum[2],mb[2],tol=CG_TOL,tStart;
+
+	if (argc > 1) nmax=atoi(argv[1]);
+	if (argc > 2) count=atoi(argv[2]);
+	if (argc > 3) tol=atof(argv[3]);
+	srand(argc > 4 ? atoi(argv[4]) : 1);
+
+	printf("Running program InteriorPoints CG benchmark, %d problems per size, CG tol %g\n\n",
+		count,tol);
+	printf("      N     M   K |  A.D.A^T: its   s/problem  SNR dB  fail     MB |"
+		"  matrix-free: its   s/problem  SNR dB  fail     MB  CG its  maxit\n");
+	for (N=256;N<=nmax;N*=2) {
+		M=N/4;
+		K=MAX(N/64,8);
+		NRsparseMat A;
+		init_Phi(M,N,A);
+		VecDoub c(N,1.0),xest(N);
+		vector<VecDoub> X(count,VecDoub(N,0.0)), Y(count);
+		for (l=0;l<count;l++) {
+			for (i=0;i<K;) {
+				j=rand()%N;
+				if (X[l][j] == 0.0) {
+					X[l][j]=(Doub)rand()/RAND_MAX+1e-3;
+					i++;
+				}
+			}
+			Y[l]=A.ax(X[l]);
+		}
+		Doub cgits=0.0;
+		Int cgfail=0;
+		for (v=0;v<2;v++) {
+			size_t b0=nralloc_bytes();
+			Intpt ip(A,false,INTPT_DENSE,v == 1);
+			ip.mehrotra=true;
+			if (ip.cg) ip.cg->tol=tol;
+			its[v]=nfail[v]=0;
+			snrsum[v]=0.0;
+			tStart=wtime();
+			for (l=0;l<count;l++) {
+				try {
+					if (ip.solve(Y[l],c,xest) != 0) nfail[v]++;
+				}
+				catch (int) {nfail[v]++;}
+				if (l == 0) mb[v]=(nralloc_bytes()-b0)/1048576.0;
+				its[v]+=ip.iter;
+				snrsum[v]+=snr(X[l],xest);
+			}
+			t[v]=(wtime()-tStart)/count;
+			if (ip.cg) {
+				cgits=(Doub)ip.cg->niter/ip.cg->nsolve;
+				cgfail=ip.cg->nfail;
+			}
+		}
+		printf("   %4d %5d %3d |  %12.1f %11.6f %7.2f %5d %6.1f |  %16.1f %11.6f %7.2f %5d %6.1f %7.1f %6d\n",
+			N,M,K,(Doub)its[0]/count,t[0],snrsum[0]/count,nfail[0],mb[0],
+			(Doub)its[1]/count,t[1],snrsum[1]/count,nfail[1],mb[1],cgits,cgfail);
+	}
+	printf("\n");
+	return 0;
+}
+
+//end of file cgbench.cpp
@@ -0,0 +1,362 @@
+#if defined(__AVX__)
+#pragma push_macro("throw")	// nr3.h's throw() would break the intrinsics headers
+#undef throw
+#include <immintrin.h>
+#pragma pop_macro("throw")
+#endif
+
+struct DenseADAT {
+// Dense alternative to ADAT and NRldl for the normal equations A.D.A^T dy = rhs of intpt.
+// Compressive sensing matrices are dense, and then the sparse scatter of ADAT::updateD and
+// the sparse LDL^T with AMD only add indexing overhead. A is the dense row major copy of
+// a MatVec; A.D.A^T is formed by a blocked SYRK kernel (dot products of rows of A.D and
+// A, swept in panels of columns that stay in cache) and factored as L.D.L^T, like NRldl,
+// by a blocked left-looking decomposition built on the same kernel. Only the lower
+// triangle is meaningful.
+// With mixed set, A.D.A^T is formed and factored in single precision, from a single
+// precision copy of A: the SYRK, which dominates, then moves half the data and does
+// twice the operations per vector instruction. solve() recovers double precision by
+// iterative refinement, with the residual rhs - A.(D.(A^T y)) computed in double by the
+// MatVec. If the refinement stalls, as it does near the optimum, where A.D.A^T is too
+// ill conditioned for single precision, A.D.A^T is formed and factored again in double
+// precision, and that factorization serves until the next updateD().
+	const MatVec &mv;
+	Int m,n,ld;
+	const Doub *Ar;			// A, row major, m x ld (MatVec::Ar)
+	VecDoub Bd;			// A.D, row major
+	VecDoub L;			// A.D.A^T and then L, row major, m x m, with D on the diagonal
+	VecDoub W;			// L times the diagonal D
+	VecDoub tmp;
+	Int nskip;			// pivots replaced in the last factorization
+	Bool mixed;			// single precision A.D.A^T and refinement
+	Bool single;			// the current A.D.A^T is single precision
+	Int nrefine,nfallback;		// refinement steps and fallbacks to double, in total
+	Doub dmax;			// largest diagonal entry of A.D.A^T
+	const VecDoub *Dp;		// D of the last updateD()
+	NRvector<float> ArF,BdF,LF,WF;	// single precision Ar, Bd, L and W
+	VecDoub tn,r,dy;		// workspace of refine()
+	DenseADAT(const MatVec &mv);
+	void updateD(const VecDoub &D);
+	void form(const VecDoub &D, Bool sp);
+	void factorize();
+	void solve(VecDoub_O &y, VecDoub &rhs);
+	Bool refine(VecDoub_O &y, VecDoub &rhs);
+};
+
+#ifndef DENSE_RTOL
+#define DENSE_RTOL 1.0e-14		// relative residual at which refinement stops
+#endif
+
+#ifndef DENSE_MAXREFINE
+#define DENSE_MAXREFINE 10		// refinement steps before falling back to double
+#endif
+
+static const Int DENSE_JB=256;		// columns of A per SYRK panel
+static const Int DENSE_NB=64;		// block size of the L.D.L^T decomposition
+
+static inline void dense_dots(const Doub *x, Int ldx, const Doub *y, Int ldy, Int len, Doub *s)
+// s[2*i+k] = x_i . y_k for the 4 rows x_i and the 2 rows y_k, over len entries
+{
+	Int j=0;
+	Doub s0=0.0,s1=0.0,s2=0.0,s3=0.0,s4=0.0,s5=0.0,s6=0.0,s7=0.0;
+	const Doub *x0=x, *x1=x+ldx, *x2=x+2*ldx, *x3=x+3*ldx, *y0=y, *y1=y+ldy;
+#if defined(__AVX__)
+	__m256d a0=_mm256_setzero_pd(),a1=a0,a2=a0,a3=a0,a4=a0,a5=a0,a6=a0,a7=a0;
+	for (;j+4<=len;j+=4) {
+		__m256d v0=_mm256_loadu_pd(y0+j), v1=_mm256_loadu_pd(y1+j), u;
+#if defined(__FMA__)
+		u=_mm256_loadu_pd(x0+j); a0=_mm256_fmadd_pd(u,v0,a0); a1=_mm256_fmadd_pd(u,v1,a1);
+		u=_mm256_loadu_pd(x1+j); a2=_mm256_fmadd_pd(u,v0,a2); a3=_mm256_fmadd_pd(u,v1,a3);
+		u=_mm256_loadu_pd(x2+j); a4=_mm256_fmadd_pd(u,v0,a4); a5=_mm256_fmadd_pd(u,v1,a5);
+		u=_mm256_loadu_pd(x3+j); a6=_mm256_fmadd_pd(u,v0,a6); a7=_mm256_fmadd_pd(u,v1,a7);
+#else
+		u=_mm256_loadu_pd(x0+j); a0=_mm256_add_pd(a0,_mm256_mul_pd(u,v0)); a1=_mm256_add_pd(a1,_mm256_mul_pd(u,v1));
+		u=_mm256_loadu_pd(x1+j); a2=_mm256_add_pd(a2,_mm256_mul_pd(u,v0)); a3=_mm256_add_pd(a3,_mm256_mul_pd(u,v1));
+		u=_mm256_loadu_pd(x2+j); a4=_mm256_add_pd(a4,_mm256_mul_pd(u,v0)); a5=_mm256_add_pd(a5,_mm256_mul_pd(u,v1));
+		u=_mm256_loadu_pd(x3+j); a6=_mm256_add_pd(a6,_mm256_mul_pd(u,v0)); a7=_mm256_add_pd(a7,_mm256_mul_pd(u,v1));
+#endif
+	}
+	Doub t[4];
+	_mm256_storeu_pd(t,a0); s0=t[0]+t[1]+t[2]+t[3];
+	_mm256_storeu_pd(t,a1); s1=t[0]+t[1]+t[2]+t[3];
+	_mm256_storeu_pd(t,a2); s2=t[0]+t[1]+t[2]+t[3];
+	_mm256_storeu_pd(t,a3); s3=t[0]+t[1]+t[2]+t[3];
+	_mm256_storeu_pd(t,a4); s4=t[0]+t[1]+t[2]+t[3];
+	_mm256_storeu_pd(t,a5); s5=t[0]+t[1]+t[2]+t[3];
+	_mm256_storeu_pd(t,a6); s6=t[0]+t[1]+t[2]+t[3];
+	_mm256_storeu_pd(t,a7); s7=t[0]+t[1]+t[2]+t[3];
+#endif
+	for (;j<len;j++) {
+		Doub v0=y0[j], v1=y1[j];
+		s0+=x0[j]*v0; s1+=x0[j]*v1;
+		s2+=x1[j]*v0; s3+=x1[j]*v1;
+		s4+=x2[j]*v0; s5+=x2[j]*v1;
+		s6+=x3[j]*v0; s7+=x3[j]*v1;
+	}
+	s[0]=s0; s[1]=s1; s[2]=s2; s[3]=s3; s[4]=s4; s[5]=s5; s[6]=s6; s[7]=s7;
+}
+
+static inline void dense_dots(const float *x, Int ldx, const float *y, Int ldy, Int len, float *s)
+// Single precision dense_dots
+{
+	Int j=0;
+	float s0=0.0f,s1=0.0f,s2=0.0f,s3=0.0f,s4=0.0f,s5=0.0f,s6=0.0f,s7=0.0f;
+	const float *x0=x, *x1=x+ldx, *x2=x+2*ldx, *x3=x+3*ldx, *y0=y, *y1=y+ldy;
+#if defined(__AVX__)
+	__m256 a0=_mm256_setzero_ps(),a1=a0,a2=a0,a3=a0,a4=a0,a5=a0,a6=a0,a7=a0;
+	for (;j+8<=len;j+=8) {
+		__m256 v0=_mm256_loadu_ps(y0+j), v1=_mm256_loadu_ps(y1+j), u;
+#if defined(__FMA__)
+		u=_mm256_loadu_ps(x0+j); a0=_mm256_fmadd_ps(u,v0,a0); a1=_mm256_fmadd_ps(u,v1,a1);
+		u=_mm256_loadu_ps(x1+j); a2=_mm256_fmadd_ps(u,v0,a2); a3=_mm256_fmadd_ps(u,v1,a3);
+		u=_mm256_loadu_ps(x2+j); a4=_mm256_fmadd_ps(u,v0,a4); a5=_mm256_fmadd_ps(u,v1,a5);
+		u=_mm256_loadu_ps(x3+j); a6=_mm256_fmadd_ps(u,v0,a6); a7=_mm256_fmadd_ps(u,v1,a7);
+#else
+		u=_mm256_loadu_ps(x0+j); a0=_mm256_add_ps(a0,_mm256_mul_ps(u,v0)); a1=_mm256_add_ps(a1,_mm256_mul_ps(u,v1));
+		u=_mm256_loadu_ps(x1+j); a2=_mm256_add_ps(a2,_mm256_mul_ps(u,v0)); a3=_mm256_add_ps(a3,_mm256_mul_ps(u,v1));
+		u=_mm256_loadu_ps(x2+j); a4=_mm256_add_ps(a4,_mm256_mul_ps(u,v0)); a5=_mm256_add_ps(a5,_mm256_mul_ps(u,v1));
+		u=_mm256_loadu_ps(x3+j); a6=_mm256_add_ps(a6,_mm256_mul_ps(u,v0)); a7=_mm256_add_ps(a7,_mm256_mul_ps(u,v1));
+#endif
+	}
+	float t[8];
+	_mm256_storeu_ps(t,a0); s0=((t[0]+t[1])+(t[2]+t[3]))+((t[4]+t[5])+(t[6]+t[7]));
+	_mm256_storeu_ps(t,a1); s1=((t[0]+t[1])+(t[2]+t[3]))+((t[4]+t[5])+(t[6]+t[7]));
+	_mm256_storeu_ps(t,a2); s2=((t[0]+t[1])+(t[2]+t[3]))+((t[4]+t[5])+(t[6]+t[7]));
+	_mm256_storeu_ps(t,a3); s3=((t[0]+t[1])+(t[2]+t[3]))+((t[4]+t[5])+(t[6]+t[7]));
+	_mm256_storeu_ps(t,a4); s4=((t[0]+t[1])+(t[2]+t[3]))+((t[4]+t[5])+(t[6]+t[7]));
+	_mm256_storeu_ps(t,a5); s5=((t[0]+t[1])+(t[2]+t[3]))+((t[4]+t[5])+(t[6]+t[7]));
+	_mm256_storeu_ps(t,a6); s6=((t[0]+t[1])+(t[2]+t[3]))+((t[4]+t[5])+(t[6]+t[7]));
+	_mm256_storeu_ps(t,a7); s7=((t[0]+t[1])+(t[2]+t[3]))+((t[4]+t[5])+(t[6]+t[7]));
+#endif
+	for (;j<len;j++) {
+		float v0=y0[j], v1=y1[j];
+		s0+=x0[j]*v0; s1+=x0[j]*v1;
+		s2+=x1[j]*v0; s3+=x1[j]*v1;
+		s4+=x2[j]*v0; s5+=x2[j]*v1;
+		s6+=x3[j]*v0; s7+=x3[j]*v1;
+	}
+	s[0]=s0; s[1]=s1; s[2]=s2; s[3]=s3; s[4]=s4; s[5]=s5; s[6]=s6; s[7]=s7;
+}
+
+template <class T>
+static void dense_gram(const T *x, const T *y, Int ldxy, Int i0, Int i1, Int k0, Int k1,
+	Int len, T alpha, T *c, Int ldc)
+/*
+ c[i][k] += alpha * (x_i . y_k) over len entries, for rows i0 <= i < i1 and columns
+ k0 <= k < k1 on or below the diagonal. Blocks that straddle the diagonal are done whole,
+ so some entries above it are overwritten as well; they are never read.
+*/
+{
+	Int i,k,ii,kk,mi,mk,kend;
+	T s[8];
+	for (i=i0;i<i1;i+=4) {
+		mi=MIN(Int(4),i1-i);
+		kend=MIN(k1,i+mi);
+		for (k=k0;k<kend;k+=2) {
+			mk=MIN(Int(2),kend-k);
+			if (mi == 4 && mk == 2) {
+				dense_dots(x+(size_t)i*ldxy,ldxy,y+(size_t)k*ldxy,ldxy,len,s);
+				for (ii=0;ii<4;ii++) {
+					c[(size_t)(i+ii)*ldc+k]+=alpha*s[2*ii];
+					c[(size_t)(i+ii)*ldc+k+1]+=alpha*s[2*ii+1];
+				}
+			}
+			else
+				for (ii=0;ii<mi;ii++)
+					for (kk=0;kk<mk;kk++) {
+						const T *xi=x+(size_t)(i+ii)*ldxy, *yk=y+(size_t)(k+kk)*ldxy;
+						T t=0;
+						for (Int j=0;j<len;j++) t+=xi[j]*yk[j];
+						c[(size_t)(i+ii)*ldc+k+kk]+=alpha*t;
+					}
+		}
+	}
+}
+
+DenseADAT::DenseADAT(const MatVec &MV) : mv(MV), m(MV.m), n(MV.n), ld(MV.ld), Ar(&MV.Ar[0]),
+	Bd(m*ld,0.0), L(m*m,0.0), W(m*m,0.0), tmp(m), nskip(0), mixed(false), single(false),
+	nrefine(0), nfallback(0), dmax(0.0), Dp(NULL) {}
+
+void DenseADAT::updateD(const VecDoub &D)
+{
+	form(D,mixed);
+}
+
+void DenseADAT::form(const VecDoub &D, Bool sp)
+// L = A.D.A^T (lower triangle), or LF in single precision if sp
+{
+	Int i,j,jb,nb;
+	Dp=&D;
+	single=sp;
+	if (single) {
+		if (ArF.size() != m*ld) {
+			ArF.resize(m*ld);
+			BdF.resize(m*ld);
+			LF.resize(m*m);
+			WF.resize(m*m);
+			tn.resize(n);
+			r.resize(m);
+			dy.resize(m);
+			for (i=0;i<m*ld;i++)
+				ArF[i]=float(Ar[i]);
+		}
+		for (i=0;i<m;i++) {
+			const float *a=&ArF[i*ld];
+			float *b=&BdF[i*ld];
+			for (j=0;j<n;j++)
+				b[j]=a[j]*float(D[j]);
+		}
+		for (i=0;i<m*m;i++)
+			LF[i]=0.0f;
+		for (jb=0;jb<n;jb+=DENSE_JB) {
+			nb=MIN(DENSE_JB,n-jb);
+			dense_gram(&BdF[jb],&ArF[jb],ld,0,m,0,m,nb,1.0f,&LF[0],m);
+		}
+		dmax=0.0;
+		for (i=0;i<m;i++)
+			dmax=MAX(dmax,Doub(LF[i*m+i]));
+		return;
+	}
+	for (i=0;i<m;i++) {
+		const Doub *a=&Ar[i*ld];
+		Doub *b=&Bd[i*ld];
+		for (j=0;j<n;j++)
+			b[j]=a[j]*D[j];
+	}
+	for (i=0;i<m*m;i++)
+		L[i]=0.0;
+	for (jb=0;jb<n;jb+=DENSE_JB) {
+		nb=MIN(DENSE_JB,n-jb);
+		dense_gram(&Bd[jb],&Ar[jb],ld,0,m,0,m,nb,1.0,&L[0],m);
+	}
+}
+
+template <class T>
+static Int dense_ldl(T *l, T *w, Int m)
+/*
+ L.D.L^T decomposition of the m x m row major l in place, by block columns of DENSE_NB: the
+ block column is first updated with all the columns to its left (the bulk of the work,
+ done by dense_gram on the rows of L.D and L), then factored column by column. Near the
+ optimum of a degenerate LP A.D.A^T becomes singular to working precision; a pivot that
+ is zero to working precision is then replaced by a huge value, which sets the
+ corresponding component of dy to zero instead of breaking down as NRldl does. Returns
+ the number of pivots replaced.
+*/
+{
+	Int i,j,k,kb,nb,nskip=0;
+	T dmax=0,t,dk;
+	const T big=T(MIN(1.0e64,sqrt(Doub(numeric_limits<T>::max()))));
+	for (i=0;i<m;i++)
+		dmax=MAX(dmax,l[i*m+i]);
+	const T tol=T(1.0e-30*dmax);
+	for (kb=0;kb<m;kb+=DENSE_NB) {
+		nb=MIN(DENSE_NB,m-kb);
+		if (kb > 0)
+			dense_gram(w,l,m,kb,m,kb,kb+nb,kb,T(-1),l,m);
+		for (k=kb;k<kb+nb;k++) {
+			T *lk=l+k*m, *wk=w+k*m;
+			t=lk[k];
+			for (j=kb;j<k;j++)
+				t-=lk[j]*wk[j];
+			if (abs(t) <= tol) {
+				t=big;
+				nskip++;
+			}
+			lk[k]=dk=t;
+			for (i=k+1;i<m;i++) {
+				T *li=l+i*m, *wi=w+i*m;
+				t=li[k];
+				for (j=kb;j<k;j++)
+					t-=wi[j]*lk[j];
+				wi[k]=t;
+				li[k]=t/dk;
+			}
+		}
+	}
+	return nskip;
+}
+
+void DenseADAT::factorize()
+// L.D.L^T decomposition of A.D.A^T in place (dense_ldl), in the precision it was formed in
+{
+	if (single)
+		nskip=dense_ldl(&LF[0],&WF[0],m);
+	else
+		nskip=dense_ldl(&L[0],&W[0],m);
+}
+
+template <class T>
+static void dense_ldlsolve(const T *l, Int m, Doub *tmp, const Doub *rhs, Doub *y)
+// Solves L.D.L^T y = rhs for the factorization in l, in double precision
+{
+	Int i,j;
+	Doub t;
+	for (i=0;i<m;i++) {
+		const T *li=l+i*m;
+		t=rhs[i];
+		for (j=0;j<i;j++)
+			t-=li[j]*tmp[j];
+		tmp[i]=t;
+	}
+	for (i=0;i<m;i++)
+		tmp[i]/=l[i*m+i];
+	for (i=m-1;i>=0;i--) {
+		const T *li=l+i*m;
+		t=tmp[i];
+		y[i]=t;
+		for (j=0;j<i;j++)
+			tmp[j]-=li[j]*t;
+	}
+}
+
+void DenseADAT::solve(VecDoub_O &y, VecDoub &rhs)
+// Solves L.D.L^T y = rhs
+{
+	if (!single) {
+		dense_ldlsolve(&L[0],m,&tmp[0],&rhs[0],&y[0]);
+		return;
+	}
+	dense_ldlsolve(&LF[0],m,&tmp[0],&rhs[0],&y[0]);
+	if (!refine(y,rhs)) {			// refinement stalled: start over in double
+		nfallback++;
+		form(*Dp,false);
+		factorize();
+		dense_ldlsolve(&L[0],m,&tmp[0],&rhs[0],&y[0]);
+	}
+}
+
+Bool DenseADAT::refine(VecDoub_O &y, VecDoub &rhs)
+/*
+ Iterative refinement of the solution y of the single precision factorization: the
+ residual in double precision through A, the correction with the factors. False if the
+ residual stops shrinking before it is down to the level of a double precision solve.
+*/
+{
+	Int i,j,it;
+	const VecDoub &D=*Dp;
+	Doub rn,ym,bm=0.0,rold=numeric_limits<Doub>::max();
+	for (i=0;i<m;i++)
+		bm=MAX(bm,abs(rhs[i]));
+	for (it=0;;it++) {
+		mv.atx(1.0,y,0.0,tn);
+		for (j=0;j<n;j++)
+			tn[j]*=D[j];
+		for (i=0;i<m;i++)
+			r[i]=rhs[i];
+		mv.ax(-1.0,tn,1.0,r);
+		rn=ym=0.0;
+		for (i=0;i<m;i++) {
+			rn=MAX(rn,abs(r[i]));
+			ym=MAX(ym,abs(y[i]));
+		}
+		if (rn <= DENSE_RTOL*(dmax*ym+bm))
+			return true;
+		if (it == DENSE_MAXREFINE || !(rn <= 0.5*rold))
+			return false;
+		rold=rn;
+		dense_ldlsolve(&LF[0],m,&tmp[0],&r[0],&dy[0]);
+		for (i=0;i<m;i++)
+			y[i]+=dy[i];
+		nrefine++;
+	}
+}
@@ -0,0 +1,243 @@
+// Subsampled fast transforms as sensing operators. A is m rows of an orthonormal transform
+// T of order n (a power of 2), A = S T with S picking rows[0..m-1], so that A.A^T = I.
+// A x is T x followed by the pick, A^T y a scatter into the picked rows followed by T^T,
+// both in O(n log n) with no stored matrix: the storage is the row list and O(n) tables
+// and workspace, against the m x n entries of an explicit Phi. The diagonal of A.D.A^T
+// the CGADAT preconditioner wants is also one transform of D. T is the Walsh-Hadamard
+// transform (HadamardOp) or the DCT-II (DCTOp); both are maximally incoherent with the
+// identity, so they suit signals that are sparse themselves.
+
+void fwht(Doub *x, Int n)
+// In place Walsh-Hadamard transform of order n, a power of 2, in natural order and
+// unnormalized: applied twice it gives n x
+{
+	Int h,i,j;
+	Doub u,v;
+	for (h=1;h<n;h*=2)
+		for (i=0;i<n;i+=2*h)
+			for (j=i;j<i+h;j++) {
+				u=x[j];
+				v=x[j+h];
+				x[j]=u+v;
+				x[j+h]=u-v;
+			}
+}
+
+struct FFT {
+// Complex FFT of order n, a power of 2, in place by radix 2 butterflies, with tables
+// of the twiddle factors and of the bit reversal permutation
+	Int n;
+	VecComplex w;			// exp(-2 pi i k/n), k < n/2
+	VecInt rev;
+	FFT(Int nn);
+	void transform(Complex *z, Int isign) const;
+};
+
+FFT::FFT(Int nn) : n(nn), w(MAX(nn/2,1)), rev(nn) {
+	Int i,j,bit;
+	const Doub pi=acos(-1.0);
+	for (i=0;i<n/2;i++)
+		w[i]=polar(1.0,-2.0*pi*i/n);
+	rev[0]=0;
+	for (i=1,j=0;i<n;i++) {
+		for (bit=n>>1;j & bit;bit>>=1)
+			j^=bit;
+		j^=bit;
+		rev[i]=j;
+	}
+}
+
+void FFT::transform(Complex *z, Int isign) const
+// z_k = sum_j z_j exp(-isign 2 pi i jk/n); the inverse (isign = -1) is not divided by n
+{
+	Int i,j,len,half,step;
+	Complex u,v,t;
+	for (i=0;i<n;i++)
+		if (i < rev[i])
+			SWAP(z[i],z[rev[i]]);
+	for (len=2;len<=n;len*=2) {
+		half=len/2;
+		step=n/len;
+		for (i=0;i<n;i+=len)
+			for (j=0;j<half;j++) {
+				t=(isign > 0 ? w[j*step] : conj(w[j*step]));
+				u=z[i+j];
+				v=z[i+j+half]*t;
+				z[i+j]=u+v;
+				z[i+j+half]=u-v;
+			}
+	}
+}
+
+struct DCT {
+// Orthonormal DCT-II of order n, a power of 2, X_k = c_k sum_j x_j cos(pi (2j+1) k/2n)
+// with c_0 = sqrt(1/n) and c_k = sqrt(2/n), and its inverse, the DCT-III. Each is one
+// complex FFT of order n of the even and reversed odd samples (Makhoul).
+	Int n;
+	FFT fft;
+	VecComplex t;			// exp(-i pi k/2n)
+	Doub c0,c1;
+	mutable VecComplex z;
+	DCT(Int nn);
+	void forward(Doub *x) const;
+	void inverse(Doub *x) const;
+};
+
+DCT::DCT(Int nn) : n(nn), fft(nn), t(nn), c0(sqrt(1.0/nn)), c1(sqrt(2.0/nn)), z(nn) {
+	const Doub pi=acos(-1.0);
+	for (Int k=0;k<n;k++)
+		t[k]=polar(1.0,-pi*k/(2.0*n));
+}
+
+void DCT::forward(Doub *x) const
+{
+	Int k;
+	for (k=0;k<n/2;k++) {
+		z[k]=x[2*k];
+		z[n-1-k]=x[2*k+1];
+	}
+	fft.transform(&z[0],1);
+	x[0]=c0*real(z[0]);
+	for (k=1;k<n;k++)
+		x[k]=c1*real(t[k]*z[k]);
+}
+
+void DCT::inverse(Doub *x) const
+{
+	Int k;
+	z[0]=x[0]/c0;
+	for (k=1;k<n;k++)
+		z[k]=conj(t[k])*Complex(x[k],-x[n-k])/c1;
+	fft.transform(&z[0],-1);
+	for (k=0;k<n/2;k++) {
+		x[2*k]=real(z[k])/n;
+		x[2*k+1]=real(z[n-1-k])/n;
+	}
+}
+
+void randomrows(Int m, Int n, VecInt &rows)
+// m distinct rows out of n, drawn with rand(), in increasing order
+{
+	VecInt pick(n,0);
+	Int i,j;
+	for (i=0;i<m;) {
+		j=rand()%n;
+		if (!pick[j]) {
+			pick[j]=1;
+			i++;
+		}
+	}
+	rows.resize(m);
+	for (i=j=0;j<n;j++)
+		if (pick[j])
+			rows[i++]=j;
+}
+
+struct SubsampledOp : LinOp {
+// The rows rows[] of an orthonormal transform T; transform and transpose apply T and T^T
+// in place to a vector of length n
+	VecInt rows;
+	mutable VecDoub buf;		// workspace: an operator is used by one thread at a time
+	SubsampledOp(const VecInt &r, Int nn);
+	virtual void transform(Doub *x) const=0;
+	virtual void transpose(Doub *x) const=0;
+	void ax(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const;
+	void atx(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const;
+};
+
+SubsampledOp::SubsampledOp(const VecInt &r, Int nn) : LinOp(r.size(),nn), rows(r), buf(nn) {
+	if (nn < 2 || (nn & (nn-1)) != 0)
+		throw("SubsampledOp: order must be a power of 2");
+	for (Int i=0;i<m;i++)
+		if (rows[i] < 0 || rows[i] >= n || (i > 0 && rows[i] <= rows[i-1]))
+			throw("SubsampledOp: rows must be increasing and less than the order");
+}
+
+void SubsampledOp::ax(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const
+// y = alpha A x + beta y
+{
+	Int i;
+	for (i=0;i<n;i++)
+		buf[i]=x[i];
+	transform(&buf[0]);
+	for (i=0;i<m;i++)
+		y[i]=(beta == 0.0 ? alpha*buf[rows[i]] : alpha*buf[rows[i]]+beta*y[i]);
+}
+
+void SubsampledOp::atx(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const
+// y = alpha A^T x + beta y
+{
+	Int i;
+	for (i=0;i<n;i++)
+		buf[i]=0.0;
+	for (i=0;i<m;i++)
+		buf[rows[i]]=x[i];
+	transpose(&buf[0]);
+	for (i=0;i<n;i++)
+		y[i]=(beta == 0.0 ? alpha*buf[i] : alpha*buf[i]+beta*y[i]);
+}
+
+struct HadamardOp : SubsampledOp {
+// Rows of the Walsh-Hadamard matrix scaled by 1/sqrt(n), which is symmetric and its own
+// inverse. Every entry is +-1/sqrt(n).
+	Doub scale;
+	HadamardOp(const VecInt &r, Int nn) : SubsampledOp(r,nn), scale(1.0/sqrt(Doub(nn))) {}
+	void transform(Doub *x) const;
+	void transpose(Doub *x) const {transform(x);}
+	void adatdiag(const VecDoub &D, VecDoub &s) const;
+};
+
+void HadamardOp::transform(Doub *x) const
+{
+	fwht(x,n);
+	for (Int i=0;i<n;i++)
+		x[i]*=scale;
+}
+
+void HadamardOp::adatdiag(const VecDoub &D, VecDoub &s) const
+// All A_ij^2 are 1/n, so every s_i is sum(D)/n
+{
+	Int i;
+	Doub sum=0.0;
+	for (i=0;i<n;i++)
+		sum+=D[i];
+	for (i=0;i<m;i++)
+		s[i]=sum/n;
+}
+
+struct DCTOp : SubsampledOp {
+// Rows of the orthonormal DCT-II
+	DCT dct;
+	DCTOp(const VecInt &r, Int nn) : SubsampledOp(r,nn), dct(nn) {}
+	void transform(Doub *x) const {dct.forward(x);}
+	void transpose(Doub *x) const {dct.inverse(x);}
+	void adatdiag(const VecDoub &D, VecDoub &s) const;
+};
+
+void DCTOp::adatdiag(const VecDoub &D, VecDoub &s) const
+// With cos^2 = (1 + cos 2.)/2, row k gives s = c_k^2 (sum(D) + C_2k)/2, where C_q =
+// sum_j D_j cos(pi (2j+1) q/2n) is the unnormalized DCT of D; C_q = -C_(2n-q) for q > n
+// and C_n = 0 fold the frequencies above n back, so one transform of D gives them all.
+{
+	Int i,k,q;
+	Doub sum=0.0,C,ck;
+	for (i=0;i<n;i++) {
+		buf[i]=D[i];
+		sum+=D[i];
+	}
+	dct.forward(&buf[0]);
+	for (i=0;i<m;i++) {
+		k=rows[i];
+		q=2*k;
+		if (q == 0)
+			C=sum;
+		else if (q < n)
+			C=buf[q]/dct.c1;
+		else if (q == n)
+			C=0.0;
+		else
+			C=-buf[2*n-q]/dct.c1;
+		ck=(k == 0 ? dct.c0 : dct.c1);
+		s[i]=SQR(ck)*0.5*(sum+C);
+	}
+}
@@ -0,0 +1,137 @@
+/*
+ Begin fastopbench.cpp
+ */
+/*
+ The interior point method on subsampled fast transforms (fastop.h) against the same
+ sensing matrices stored explicitly. For N from 256 up to nmax, M = N/4 rows of the
+ orthonormal Walsh-Hadamard or DCT-II matrix of order N are drawn at random, count
+ K-sparse x >= 0 are generated, K = N/64 (at least 8), and y = Phi x is decoded with
+ Mehrotra steps three ways: the default path on the explicit Phi (A.D.A^T formed and
+ factored densely), the matrix-free path on the explicit Phi (CGADAT on the stored
+ matrix) and the matrix-free path on the operator, which stores no matrix. Memory is what
+ NRvector and NRmatrix allocate from the construction of the Intpt (and of the operator)
+ through its first solve (nralloc_bytes()); the explicit Phi is built before and not
+ counted.
+
+ Usage: fastopbench [nmax [count [dct [seed]]]]   (default 4096 3 1 1; dct 0: Hadamard)
+ */
+#include "nr3.h"
+#include "sparse.h"
+#include "NRldl.h"
+#include "intpt.h"
+
+void init_Phi(const SubsampledOp &op, NRsparseMat &a)
+// The operator as an explicit matrix in compressed column storage, column j = A e_j
+{
+	Int i,j,M=op.m,N=op.n;
+	VecDoub e(N,0.0),col(M);
+	a=NRsparseMat(M,N,M*N);
+	for (j=0;j<N;j++) {
+		e[j]=1.0;
+		op.ax(1.0,e,0.0,col);
+		e[j]=0.0;
+		a.col_ptr[j]=j*M;
+		for (i=0;i<M;i++) {
+			a.row_ind[j*M+i]=i;
+			a.val[j*M+i]=col[i];
+		}
+	}
+	a.col_ptr[N]=M*N;
+}
+
+Doub wtime()
+// Wall clock seconds; clock() would add up the time of all threads
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec+1.0e-9*ts.tv_nsec;
+}
+
+Doub snr(VecDoub_I &xact, VecDoub_I &xest)
+{
+	Doub MSE=0.0, Ps=0.0;
+	for (Int i=0;i<xact.size();i++) {
+		MSE+=SQR(xact[i]-xest[i]);
+		Ps+=SQR(xact[i]);
+	}
+	return 10*log10(Ps/MSE);
+}
+
+SubsampledOp *new_op(Bool dct, const VecInt &rows, Int N)
+{
+	if (dct)
+		return new DCTOp(rows,N);
+	return new HadamardOp(rows,N);
+}
+
+Int main(int argc, char **argv) {
+
+	Int i,j,l,v,M,N,K,nmax=4096,count=3,its[3],nfail[3];
+	Doub t[3],snrsum[3],mb[3],tStart;
+	Bool dct=true;
+
+	if (argc > 1) nmax=atoi(argv[1]);
+	if (argc > 2) count=atoi(argv[2]);
+	if (argc > 3) dct=atoi(argv[3]) != 0;
+	srand(argc > 4 ? atoi(argv[4]) : 1);
+
+	printf("Running program InteriorPoints fast operator benchmark, %s rows, %d problems per size\n\n",
+		dct ? "DCT" : "Hadamard",count);
+	printf("      N     M   K |  explicit A.D.A^T: its  s/problem  SNR dB  fail     MB |"
+		"  explicit CG: its  s/problem  SNR dB  fail     MB |"
+		"  operator CG: its  s/problem  SNR dB  fail     MB\n");
+	for (N=256;N<=nmax;N*=2) {
+		M=N/4;
+		K=MAX(N/64,8);
+		VecInt rows;
+		randomrows(M,N,rows);
+		NRsparseMat A;
+		{
+			SubsampledOp *op=new_op(dct,rows,N);
+			init_Phi(*op,A);
+			delete op;
+		}
+		VecDoub c(N,1.0),xest(N);
+		vector<VecDoub> X(count,VecDoub(N,0.0)), Y(count);
+		for (l=0;l<count;l++) {
+			for (i=0;i<K;) {
+				j=rand()%N;
+				if (X[l][j] == 0.0) {
+					X[l][j]=(Doub)rand()/RAND_MAX+1e-3;
+					i++;
+				}
+			}
+			Y[l]=A.ax(X[l]);
+		}
+		for (v=0;v<3;v++) {
+			size_t b0=nralloc_bytes();
+			SubsampledOp *op=(v == 2 ? new_op(dct,rows,N) : NULL);
+			Intpt *ip=(v == 2 ? new Intpt(*op,false) : new Intpt(A,false,INTPT_DENSE,v == 1));
+			ip->mehrotra=true;
+			its[v]=nfail[v]=0;
+			snrsum[v]=0.0;
+			tStart=wtime();
+			for (l=0;l<count;l++) {
+				try {
+					if (ip->solve(Y[l],c,xest) != 0) nfail[v]++;
+				}
+				catch (int) {nfail[v]++;}
+				if (l == 0) mb[v]=(nralloc_bytes()-b0)/1048576.0;
+				its[v]+=ip->iter;
+				snrsum[v]+=snr(X[l],xest);
+			}
+			t[v]=(wtime()-tStart)/count;
+			delete ip;
+			delete op;
+		}
+		printf("   %4d %5d %3d |  %21.1f %10.6f %7.2f %5d %6.1f |  %16.1f %10.6f %7.2f %5d %6.1f |"
+			"  %16.1f %10.6f %7.2f %5d %6.2f\n",N,M,K,
+			(Doub)its[0]/count,t[0],snrsum[0]/count,nfail[0],mb[0],
+			(Doub)its[1]/count,t[1],snrsum[1]/count,nfail[1],mb[1],
+			(Doub)its[2]/count,t[2],snrsum[2]/count,nfail[2],mb[2]);
+	}
+	printf("\n");
+	return 0;
+}
+
+//end of file fastopbench.cpp
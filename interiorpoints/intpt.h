@@ -0,0 +1,390 @@
+#include "matvec.h"
+#include "denseadat.h"
+#include "cgadat.h"
+#include "fastop.h"
+
+Doub dotprod(VecDoub_I &x, VecDoub_I &y)
+// Compute the dot product of two vectors, x dot y
+{
+	Doub sum=0.0;
+	for (Int i=0;i<x.size();i++)
+		sum += x[i]*y[i];
+	return sum;
+}
+
+#ifndef INTPT_DENSE
+#define INTPT_DENSE 0.3	// density of A from which the dense normal equations are used
+#endif
+
+#ifndef INTPT_MEHROTRA
+#define INTPT_MEHROTRA 0	// default of Intpt::mehrotra
+#endif
+
+#ifndef INTPT_MIXED
+#define INTPT_MIXED 0		// default of Intpt::mixed
+#endif
+
+#ifndef INTPT_WARM
+#define INTPT_WARM 0		// default of Intpt::warm
+#endif
+
+#ifndef INTPT_WARMMU
+#define INTPT_WARMMU 1.0e-2	// default of Intpt::warmmu
+#endif
+
+#ifndef INTPT_MATFREE
+#define INTPT_MATFREE 0		// default matfree argument of the Intpt constructor
+#endif
+
+Doub steplength(VecDoub_I &v, VecDoub_I &dv)
+// Largest alpha <= 1 with v + alpha dv >= 0
+{
+	Doub alpha=1.0;
+	for (Int j=0;j<v.size();j++)
+		if (dv[j] < 0.0 && v[j]+alpha*dv[j] < 0.0)
+			alpha=-v[j]/dv[j];
+	return alpha;
+}
+
+struct Intpt {
+// Interior point method of intpt as a reusable solver for one constraint matrix. The
+// transpose, the pattern of A.D.A^T, the AMD ordering and the symbolic factorization
+// depend only on A and are set up once by the constructor; every call of solve() then
+// does only numeric work, which pays off when many b's are decoded with the same Phi.
+// Products with A and A^T go through a MatVec. If A is at least INTPT_DENSE full, that
+// keeps A dense and A.D.A^T is formed and factored densely (DenseADAT) instead of by
+// ADAT and the sparse LDL^T of NRldl. With matfree, A.D.A^T is neither formed nor
+// factored: the normal equations are solved by preconditioned conjugate gradients with
+// products by A and A^T only (CGADAT).
+// An Intpt can also be built on a LinOp instead of an explicit A, such as the subsampled
+// fast transforms of fastop.h; A is then never stored and the normal equations are
+// always solved matrix-free.
+// With mehrotra set, solve() takes Mehrotra predictor-corrector steps instead of the
+// fixed centering of intpt: each factorization of A.D.A^T serves an affine scaling
+// solve, which sets the centering parameter, and a corrector solve with the second
+// order term, and the steps go to a fraction of the boundary that tends to 1.
+// With mixed set, A.D.A^T is factored in single precision and the solves are refined
+// to double precision (DenseADAT::mixed, NRldl::mixed). Once the refinement has stalled,
+// A.D.A^T only gets worse conditioned, so the rest of that solve() factors in double.
+// With warm set, solve() starts from the solution of the last successful solve() instead
+// of x = z = y = 1000, which suits streams of slowly varying b. That point lies on the
+// boundary, where the method stalls, so it is first recentered (warmstart()). When the
+// support of the solution changes, the warm start can stall all the same; so it is
+// given as many iterations as the last cold start took, and if it has not converged by
+// then the solve is repeated from the cold start.
+	Int m,n;
+	NRsparseMat at;			// A^T, empty on a LinOp
+	MatVec *mv;			// products with an explicit A, NULL on a LinOp
+	const LinOp &op;		// products with A: *mv or the LinOp
+	ADAT *adat;
+	NRldl *solver;
+	DenseADAT *dense;
+	CGADAT *cg;
+	VecDoub y,z,rp,rd,d,dx,dy,dz,rhs,tempn,rxz;	// workspace: solve() does no allocation
+	VecDoub xw;				// x of the last successful solve
+	Bool verbose;				// print the iteration table
+	Bool mehrotra;				// predictor-corrector steps
+	Bool mixed;				// single precision factorization, refined solves
+	Bool stalled;				// refinement stalled in this solve(): factor in double
+	Bool warm;				// warm start from the last solution
+	Doub warmmu;				// normalized duality gap of the recentered warm start
+	Bool havewarm;				// xw, y and z hold a solution
+	Int coldits;				// iterations of the last cold started solve
+	Int iter;				// iterations of the last solve
+	Int nsolve,nwarm,nrestart;		// solves, warm started ones and cold restarts, in total
+	Intpt(const NRsparseMat &A, Bool verb=true, Doub densefrac=INTPT_DENSE,
+		Bool matfree=INTPT_MATFREE);
+	Intpt(const LinOp &A, Bool verb=true);
+	Int solve(VecDoub_I &b, VecDoub_I &c, VecDoub_O &x);
+	Int iterate(VecDoub_I &b, VecDoub_I &c, VecDoub_O &x, Bool fromwarm, Int maxits);
+	void warmstart(VecDoub_I &c, VecDoub_O &x);
+	void factorize(VecDoub_I &D);
+	void normsolve(VecDoub_O &y, VecDoub &rhs);
+	void direction();
+	~Intpt();
+};
+
+Intpt::Intpt(const NRsparseMat &A, Bool verb, Doub densefrac, Bool matfree) : m(A.nrows),
+	n(A.ncols), at(A.transpose()), mv(new MatVec(A,at,densefrac)), op(*mv), adat(NULL),
+	solver(NULL), dense(NULL), cg(NULL), y(m),z(n),
+	rp(m),rd(n),d(n),dx(n),dy(m),dz(n),rhs(m),tempn(n),rxz(n),xw(n),
+	verbose(verb), mehrotra(INTPT_MEHROTRA), mixed(INTPT_MIXED), stalled(false),
+	warm(INTPT_WARM), warmmu(INTPT_WARMMU), havewarm(false), coldits(0), iter(0), nsolve(0),
+	nwarm(0), nrestart(0) {
+	if (matfree) {
+		cg=new CGADAT(op);
+		if (verbose)
+			cout << "Matrix-free normal equations of order " << m << endl;
+	}
+	else if (mv->dense) {
+		dense=new DenseADAT(*mv);
+		if (verbose)
+			cout << "Dense normal equations of order " << m << endl;
+	}
+	else {
+		adat=new ADAT(A,at);
+		solver=new NRldl(adat->ref());
+		solver->verbose=verb;
+		solver->order();
+	}
+}
+
+Intpt::Intpt(const LinOp &A, Bool verb) : m(A.m), n(A.n), mv(NULL), op(A), adat(NULL),
+	solver(NULL), dense(NULL), cg(new CGADAT(A)), y(m),z(n),
+	rp(m),rd(n),d(n),dx(n),dy(m),dz(n),rhs(m),tempn(n),rxz(n),xw(n),
+	verbose(verb), mehrotra(INTPT_MEHROTRA), mixed(INTPT_MIXED), stalled(false),
+	warm(INTPT_WARM), warmmu(INTPT_WARMMU), havewarm(false), coldits(0), iter(0), nsolve(0),
+	nwarm(0), nrestart(0) {
+	if (verbose)
+		cout << "Matrix-free normal equations of order " << m << endl;
+}
+
+void Intpt::factorize(VecDoub_I &D)
+// Forms and factors A.D.A^T
+{
+	if (cg) {
+		cg->updateD(D);
+		cg->factorize();
+	}
+	else if (dense) {
+		dense->mixed=mixed && !stalled;
+		dense->updateD(D);
+		dense->factorize();
+	}
+	else {
+		solver->mixed=mixed && !stalled;
+		adat->updateD(D);
+		solver->factorize();
+	}
+}
+
+void Intpt::normsolve(VecDoub_O &y, VecDoub &rhs)
+// Solves A.D.A^T y = rhs with the factorization of the last call of factorize
+{
+	Int nfallback;
+	if (cg)
+		cg->solve(y,rhs);
+	else if (dense) {
+		nfallback=dense->nfallback;
+		dense->solve(y,rhs);
+		stalled=stalled || dense->nfallback > nfallback;
+	}
+	else {
+		nfallback=solver->nfallback;
+		solver->solve(y,rhs);
+		stalled=stalled || solver->nfallback > nfallback;
+	}
+}
+
+void Intpt::direction()
+/*
+ Newton direction (dx,dy,dz) for the residuals rp, rd and Z dx + X dz = rxz, with the
+ factorization of A.D.A^T for the current D = X/Z:
+	A.D.A^T dy = -rp - A (rxz/z + D rd),  dz = -A^T dy - rd,  dx = rxz/z - D dz
+*/
+{
+	Int i,j;
+	for (j=0;j<n;j++)
+		tempn[j]=-rxz[j]/z[j]-d[j]*rd[j];
+	for (i=0;i<m;i++)
+		rhs[i]=-rp[i];
+	op.ax(1.0,tempn,1.0,rhs);
+	normsolve(dy,rhs);
+	for (j=0;j<n;j++)
+		dz[j]=rd[j];
+	op.atx(-1.0,dy,-1.0,dz);
+	for (j=0;j<n;j++)
+		dx[j]=rxz[j]/z[j]-d[j]*dz[j];
+}
+
+Intpt::~Intpt() {
+	delete cg;
+	delete mv;
+	delete dense;
+	delete solver;
+	delete adat;
+}
+
+Int Intpt::solve(VecDoub_I &b, VecDoub_I &c, VecDoub_O &x)
+// Same arguments and return values as intpt
+{
+	const Int MAXITS=200;
+	Int status,its;
+	Bool fromwarm=warm && havewarm;
+	havewarm=false;
+	nsolve++;
+	if (fromwarm) {
+		nwarm++;
+		status=iterate(b,c,x,true,coldits);
+		if (status != 0) {
+			nrestart++;
+			its=iter;
+			status=iterate(b,c,x,false,MAXITS);
+			coldits=iter;
+			iter+=its;
+		}
+	}
+	else {
+		status=iterate(b,c,x,false,MAXITS);
+		coldits=iter;
+	}
+	if (status == 0) {
+		for (Int j=0;j<n;j++)
+			xw[j]=x[j];
+		havewarm=true;
+	}
+	return status;
+}
+
+void Intpt::warmstart(VecDoub_I &c, VecDoub_O &x)
+/*
+ Recentered starting point from the last solution xw, y, z. At an optimum x_j z_j = 0,
+ and components that close to the boundary only allow tiny steps; so every pair is moved
+ to x_j z_j >= mu by raising the smaller of the two, or both to sqrt(mu) if both are
+ smaller than that. mu = warmmu (1 + |c.x|)/n starts the iteration at a normalized gap
+ of about warmmu. y is kept as it is; the residuals of the new b are left to the
+ infeasible iteration.
+*/
+{
+	Doub mu=warmmu*(1.0+abs(dotprod(c,xw)))/n, smu=sqrt(mu);
+	for (Int j=0;j<n;j++) {
+		x[j]=xw[j];
+		if (x[j]*z[j] >= mu)
+			continue;
+		if (x[j] < smu && z[j] < smu)
+			x[j]=z[j]=smu;
+		else if (x[j] >= z[j])
+			z[j]=mu/x[j];
+		else
+			x[j]=mu/z[j];
+	}
+}
+
+Int Intpt::iterate(VecDoub_I &b, VecDoub_I &c, VecDoub_O &x, Bool fromwarm, Int maxits)
+// The iteration of solve(), from the cold start or the recentered last solution
+{
+	const Doub EPS=1.0e-6;
+	const Doub SIGMA=0.9;
+	const Doub DELTA=0.02;
+	const Doub ETAMIN=0.9,ETAMAX=0.995;
+	const Doub BIG=numeric_limits<Doub>::max();
+	Int i,j,status;
+	Doub rpfact=1.0+sqrt(dotprod(b,b));
+	Doub rdfact=1.0+sqrt(dotprod(c,c));
+	if (fromwarm)
+		warmstart(c,x);
+	else {
+		for (j=0;j<n;j++) {
+			x[j]=1000.0;
+			z[j]=1000.0;
+		}
+		for (i=0;i<m;i++) {
+			y[i]=1000.0;
+		}
+	}
+	stalled=false;
+	Doub normrp_old=BIG;
+	Doub normrd_old=BIG;
+	if (verbose) {
+		cout << setw(4) << "iter" << setw(12) << "Primal obj." << setw(9) <<
+			"||r_p||" << setw(13) << "Dual obj." << setw(11) << "||r_d||" <<
+			setw(13) << "duality gap" << setw(16) << "normalized gap" << endl;
+		cout << scientific << setprecision(4);
+	}
+	for (iter=0;iter<maxits;iter++) {
+		for (i=0;i<m;i++)
+			rp[i]=-b[i];
+		op.ax(1.0,x,1.0,rp);
+		Doub normrp=sqrt(dotprod(rp,rp))/rpfact;
+		for (j=0;j<n;j++)
+			rd[j]=z[j]-c[j];
+		op.atx(1.0,y,1.0,rd);
+		Doub normrd=sqrt(dotprod(rd,rd))/rdfact;
+		Doub gamma=dotprod(x,z);
+		Doub mu=DELTA*gamma/n;
+		Doub primal_obj=dotprod(c,x);
+		Doub dual_obj=dotprod(b,y);
+		Doub gamma_norm=gamma/(1.0+abs(primal_obj));
+		if (verbose)
+			cout << setw(3) << iter << setw(12) << primal_obj << setw(12) <<
+				normrp << setw(12) << dual_obj << setw(12) << normrd << setw(12)
+				<< gamma << setw(12) << gamma_norm<<endl;
+		if (normrp < EPS && normrd < EPS && gamma_norm < EPS)
+			return status=0;
+		if (normrp > 1000*normrp_old && normrp > EPS)
+			return status=1;
+		if (normrd > 1000*normrd_old && normrd > EPS)
+			return status=2;
+		for (j=0;j<n;j++)
+			d[j]=x[j]/z[j];
+		factorize(d);
+		Doub alpha_p,alpha_d;
+		if (mehrotra) {
+			// predictor: affine scaling direction
+			for (j=0;j<n;j++)
+				rxz[j]=-x[j]*z[j];
+			direction();
+			alpha_p=steplength(x,dx);
+			alpha_d=steplength(z,dz);
+			Doub gamma_aff=0.0;
+			for (j=0;j<n;j++)
+				gamma_aff+=(x[j]+alpha_p*dx[j])*(z[j]+alpha_d*dz[j]);
+			Doub sigma=pow(gamma_aff/gamma,3);
+			// corrector: centering and the second order term of the predictor
+			for (j=0;j<n;j++)
+				rxz[j]=sigma*gamma/n-x[j]*z[j]-dx[j]*dz[j];
+			direction();
+			Doub eta=MAX(ETAMIN,MIN(ETAMAX,1.0-sigma));
+			alpha_p=eta*steplength(x,dx);
+			alpha_d=eta*steplength(z,dz);
+		}
+		else {
+			for (j=0;j<n;j++)
+				tempn[j]=x[j]-mu/z[j]-d[j]*rd[j];
+			for (i=0;i<m;i++)
+				rhs[i]=-rp[i];
+			op.ax(1.0,tempn,1.0,rhs);
+			normsolve(dy,rhs);
+			for (j=0;j<n;j++)
+				dz[j]=rd[j];
+			op.atx(-1.0,dy,-1.0,dz);
+			for (j=0;j<n;j++)
+				dx[j]=-d[j]*dz[j]+mu/z[j]-x[j];
+			alpha_p=1.0;
+			for (j=0;j<n;j++)
+				if (x[j]+alpha_p*dx[j] < 0.0)
+					alpha_p=-x[j]/dx[j];
+			alpha_d=1.0;
+			for (j=0;j<n;j++)
+				if (z[j]+alpha_d*dz[j] < 0.0)
+					alpha_d=-z[j]/dz[j];
+			alpha_p = MIN(alpha_p*SIGMA,1.0);
+			alpha_d = MIN(alpha_d*SIGMA,1.0);
+		}
+		for (j=0;j<n;j++) {
+			x[j]+=alpha_p*dx[j];
+			z[j]+=alpha_d*dz[j];
+		}
+		for (i=0;i<m;i++)
+			y[i]+=alpha_d*dy[i];
+		normrp_old=normrp;
+		normrd_old=normrd;
+	}
+	return status=3;
+}
+
+Int intpt(const NRsparseMat &a, VecDoub_I &b, VecDoub_I &c, VecDoub_O &x)
+/*
+ Interior point method for linear programming. On input a contains the coefficient matrix for the 
+ constraints in the form of A dot x = b. The right-handed side of the contraints is input in b[0...m-1].
+ The coefficients of the objective function to be minimized, c dot x, are input in c[0...n-1]. Note
+ that c should generally be padded with zeros corresponding to the slack variables that extend
+ the number of columns to be n. The function returns 0 if an optimal solution is found; 1 if 
+ the problem is infeasible; 2 if the dual problem is infeasible, i.e., if the problem is unbounded
+ or perhaps infeasiblele; and 3 if the number of iterations is exceeded.  The solution is returned in
+ x[0...n-1]. For a sequence of problems with the same a, construct one Intpt and call its solve().
+*/
+{
+	Intpt ip(a);
+	return ip.solve(b,c,x);
+}
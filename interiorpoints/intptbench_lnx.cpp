@@ -0,0 +1,126 @@
+/*
+ Begin intptbench.cpp
+ */
+/*
+ Iteration counts and run times of the interior point method with the fixed centering of
+ intpt and with Mehrotra predictor-corrector steps (Intpt::mehrotra), over the problem
+ sizes of param_gen.m. For every size, count problems are generated with a dense Phi,
+ entries uniform in [0,1), and a K-sparse nonnegative x as in param_gen.m; both variants
+ solve the same problems with the same Intpt, so they share the setup of A.D.A^T. A solve
+ whose factorization breaks down is counted as a failure. The alloc columns count the
+ blocks NRvector and NRmatrix allocate during the solves (nralloc_count()), which should
+ be none: solve() works in the storage of its Intpt. A second table compares Mehrotra
+ steps with A.D.A^T factored in double precision and in single precision with refined
+ solves (Intpt::mixed), with the refinement steps per solve and the factorizations per
+ problem that fell back to double precision.
+
+ Usage: intptbench [count [seed]]   (default 20 1)
+ */
+#include "nr3.h"
+#include "sparse.h"
+#include "NRldl.h"
+#include "intpt.h"
+
+void init_Phi(Int M, Int N, NRsparseMat &a)
+// Dense random Phi in compressed column storage
+{
+	Int i,j;
+	a=NRsparseMat(M,N,M*N);
+	for (j=0;j<N;j++) {
+		a.col_ptr[j]=j*M;
+		for (i=0;i<M;i++) {
+			a.row_ind[j*M+i]=i;
+			a.val[j*M+i]=(Doub)rand()/RAND_MAX;
+		}
+	}
+	a.col_ptr[N]=M*N;
+}
+
+Doub snr(VecDoub_I &xact, VecDoub_I &xest)
+{
+	Doub MSE=0.0, Ps=0.0;
+	for (Int i=0;i<xact.size();i++) {
+		MSE+=SQR(xact[i]-xest[i]);
+		Ps+=SQR(xact[i]);
+	}
+	return 10*log10(Ps/MSE);
+}
+
+Int main(int argc, char **argv) {
+
+	const Int NSIZES=8;
+	const Int sizes[NSIZES][3]={{10,6,1},{20,11,2},{30,11,2},{40,11,3},{80,16,3},
+		{256,80,8},{512,128,12},{1024,256,20}};		// N, M, K
+	Int i,j,l,s,v,M,N,k,count=20,its[NSIZES][3],nfail[NSIZES][3],nref,nfall;
+	size_t nalloc[2];
+	Doub t[NSIZES][3],snrsum[NSIZES][3],refine[NSIZES],fallback[NSIZES];
+	NRsparseMat A;
+
+	if (argc > 1) count=atoi(argv[1]);
+	srand(argc > 2 ? atoi(argv[2]) : 1);
+
+	printf("Running program InteriorPoints benchmark, %d problems per size\n\n", count);
+	printf("      N    M   K |  path following: its   s/problem  SNR dB  fail alloc |"
+		"  Mehrotra: its   s/problem  SNR dB  fail alloc\n");
+	for (s=0;s<NSIZES;s++) {
+		N=sizes[s][0];
+		M=sizes[s][1];
+		k=sizes[s][2];
+		init_Phi(M,N,A);
+		VecDoub c(N,1.0),xest(N);
+		vector<VecDoub> X(count,VecDoub(N,0.0)), Y(count);
+		for (l=0;l<count;l++) {
+			for (i=0;i<k;) {
+				j=rand()%N;
+				if (X[l][j] == 0.0) {
+					X[l][j]=(Doub)rand()/RAND_MAX+1e-3;
+					i++;
+				}
+			}
+			Y[l]=A.ax(X[l]);
+		}
+		Intpt ip(A,false);
+		for (v=0;v<3;v++) {
+			ip.mehrotra=(v >= 1);
+			ip.mixed=(v == 2);
+			its[s][v]=nfail[s][v]=0;
+			snrsum[s][v]=0.0;
+			nref=(ip.dense ? ip.dense->nrefine : ip.solver->nrefine);
+			nfall=(ip.dense ? ip.dense->nfallback : ip.solver->nfallback);
+			size_t n0 = nralloc_count();
+			clock_t tStart = clock();
+			for (l=0;l<count;l++) {
+				try {
+					if (ip.solve(Y[l],c,xest) != 0) nfail[s][v]++;
+				}
+				catch (int) {nfail[s][v]++;}
+				its[s][v]+=ip.iter;
+				snrsum[s][v]+=snr(X[l],xest);
+			}
+			t[s][v] = (double)(clock() - tStart)/CLOCKS_PER_SEC/count;
+			if (v < 2)
+				nalloc[v] = nralloc_count() - n0;
+			else {
+				nref=(ip.dense ? ip.dense->nrefine : ip.solver->nrefine)-nref;
+				nfall=(ip.dense ? ip.dense->nfallback : ip.solver->nfallback)-nfall;
+				refine[s]=(Doub)nref/(2*its[s][v]);
+				fallback[s]=(Doub)nfall/count;
+			}
+		}
+		printf("   %4d %4d %3d |  %18.1f %11.6f %7.2f %5d %5d |  %12.1f %11.6f %7.2f %5d %5d\n",
+			N,M,k,(Doub)its[s][0]/count,t[s][0],snrsum[s][0]/count,nfail[s][0],(Int)nalloc[0],
+			(Doub)its[s][1]/count,t[s][1],snrsum[s][1]/count,nfail[s][1],(Int)nalloc[1]);
+	}
+	printf("\n      N    M   K |     double: its   s/problem  SNR dB  fail |"
+		"  mixed: its   s/problem  SNR dB  fail refine fallback speedup\n");
+	for (s=0;s<NSIZES;s++)
+		printf("   %4d %4d %3d |  %13.1f %11.6f %7.2f %5d |  %9.1f %11.6f %7.2f %5d %6.2f %8.2f %7.2f\n",
+			sizes[s][0],sizes[s][1],sizes[s][2],
+			(Doub)its[s][1]/count,t[s][1],snrsum[s][1]/count,nfail[s][1],
+			(Doub)its[s][2]/count,t[s][2],snrsum[s][2]/count,nfail[s][2],
+			refine[s],fallback[s],t[s][1]/t[s][2]);
+	printf("\n");
+	return 0;
+}
+
+//end of file intptbench.cpp
@@ -0,0 +1,181 @@
+/*
+ Begin intptstream.cpp
+ */
+/*
+ Decoding a stream of measurement vectors y_t = Phi x_t that share one Phi with the
+ interior point method. Phi is M x N with entries uniform in [0,1) and x_t is K-sparse
+ and nonnegative as in param_gen.m; from one vector to the next the amplitudes change by
+ a few percent and now and then one nonzero moves. Every vector is solved twice: by
+ intpt() as before, which sets up the transpose, A.D.A^T pattern, AMD ordering and
+ symbolic factorization on every call, and by one Intpt object that keeps them; both use
+ the sparse L.D.L^T. A third pass reuses an Intpt on the dense normal equations
+ (DenseADAT). A solve whose factorization breaks down (intpt throws when a pivot of
+ L.D.L^T is zero) is counted as a failure. Last, the stream is decoded on the dense
+ normal equations with and without warm starts (Intpt::warm), both with the fixed
+ centering and with Mehrotra steps; restarts are warm starts that did not converge within
+ the iterations of a cold start and were repeated cold, and their iterations are counted.
+
+ Usage: intptstream [M N K [count [seed]]]   (default 80 256 8 200 1)
+ */
+#include "nr3.h"
+#include "sparse.h"
+#include "NRldl.h"
+#include "intpt.h"
+
+void init_Phi(Int M, Int N, NRsparseMat &a)
+// Dense random Phi in compressed column storage
+{
+	Int i,j;
+	a=NRsparseMat(M,N,M*N);
+	for (j=0;j<N;j++) {
+		a.col_ptr[j]=j*M;
+		for (i=0;i<M;i++) {
+			a.row_ind[j*M+i]=i;
+			a.val[j*M+i]=(Doub)rand()/RAND_MAX;
+		}
+	}
+	a.col_ptr[N]=M*N;
+}
+
+Doub snr(VecDoub_I &xact, VecDoub_I &xest)
+{
+	Doub MSE=0.0, Ps=0.0;
+	for (Int i=0;i<xact.size();i++) {
+		MSE+=SQR(xact[i]-xest[i]);
+		Ps+=SQR(xact[i]);
+	}
+	return 10*log10(Ps/MSE);
+}
+
+Int main(int argc, char **argv) {
+
+	Int i,j,l,M=80,N=256,k=8,count=200,its,nfail;
+	Doub t_cold,t_warm,t_dense,snrsum;
+	NRsparseMat A;
+
+	if (argc > 3) {
+		M=atoi(argv[1]);
+		N=atoi(argv[2]);
+		k=atoi(argv[3]);
+	}
+	if (argc > 4) count=atoi(argv[4]);
+	srand(argc > 5 ? atoi(argv[5]) : 1);
+
+	init_Phi(M,N,A);
+	VecDoub c(N,1.0),x(N),y(M),xest(N);
+	vector<VecDoub> X(count,VecDoub(N,0.0)), Y(count,VecDoub(M,0.0));
+	VecInt idx(k);
+	for (i=0;i<k;) {
+		j=rand()%N;
+		if (X[0][j] == 0.0) {
+			X[0][j]=(Doub)rand()/RAND_MAX+1e-3;
+			idx[i++]=j;
+		}
+	}
+	for (l=1;l<count;l++) {
+		for (i=0;i<k;i++)
+			X[l][idx[i]]=X[l-1][idx[i]]*(1.0+0.05*(2.0*rand()/RAND_MAX-1.0));
+		if (rand()%20 == 0) {
+			i=rand()%k;
+			j=rand()%N;
+			if (X[l][j] == 0.0) {
+				X[l][j]=X[l][idx[i]];
+				X[l][idx[i]]=0.0;
+				idx[i]=j;
+			}
+		}
+	}
+	for (l=0;l<count;l++)
+		Y[l]=A.ax(X[l]);
+
+	printf("Running program InteriorPoints stream %d-%d-%d, %d vectors\n", N,M,k,count);
+
+	// a full setup for every vector, as intpt() does
+	its=nfail=0;
+	snrsum=0.0;
+	clock_t tStart = clock();
+	for (l=0;l<count;l++) {
+		Intpt ip(A,false,2.0);
+		try {
+			if (ip.solve(Y[l],c,xest) != 0) nfail++;
+		}
+		catch (int) {nfail++;}
+		its+=ip.iter;
+		snrsum+=snr(X[l],xest);
+	}
+	t_cold = (double)(clock() - tStart)/CLOCKS_PER_SEC/count;
+	printf("\n       Setup per call:  %.1f iterations/vector, %.6fs/vector, failures %d, mean SNR %.2f dB\n",
+		(Doub)its/count, t_cold, nfail, snrsum/count);
+
+	// one solver for the whole stream
+	its=nfail=0;
+	snrsum=0.0;
+	tStart = clock();
+	Intpt ip(A,false,2.0);
+	for (l=0;l<count;l++) {
+		try {
+			if (ip.solve(Y[l],c,xest) != 0) nfail++;
+		}
+		catch (int) {nfail++;}
+		its+=ip.iter;
+		snrsum+=snr(X[l],xest);
+	}
+	t_warm = (double)(clock() - tStart)/CLOCKS_PER_SEC/count;
+	printf("       Reused solver:   %.1f iterations/vector, %.6fs/vector, failures %d, mean SNR %.2f dB\n",
+		(Doub)its/count, t_warm, nfail, snrsum/count);
+
+	// one solver on the dense normal equations
+	its=nfail=0;
+	snrsum=0.0;
+	tStart = clock();
+	Intpt ipd(A,false,0.0);
+	for (l=0;l<count;l++) {
+		try {
+			if (ipd.solve(Y[l],c,xest) != 0) nfail++;
+		}
+		catch (int) {nfail++;}
+		its+=ipd.iter;
+		snrsum+=snr(X[l],xest);
+	}
+	t_dense = (double)(clock() - tStart)/CLOCKS_PER_SEC/count;
+	printf("       Dense solver:    %.1f iterations/vector, %.6fs/vector, failures %d, mean SNR %.2f dB\n",
+		(Doub)its/count, t_dense, nfail, snrsum/count);
+	printf("       Speedup per vector: reused %.2f, dense %.2f\n\n", t_cold/t_warm, t_cold/t_dense);
+
+	// warm starts from the previous solution, with both kinds of steps, on the dense solver
+	for (Int v=0;v<2;v++) {
+		Int itscold=0;
+		for (Int w=0;w<2;w++) {
+			its=nfail=0;
+			snrsum=0.0;
+			tStart = clock();
+			Intpt ipw(A,false,0.0);
+			ipw.mehrotra=(v == 1);
+			ipw.warm=(w == 1);
+			for (l=0;l<count;l++) {
+				try {
+					if (ipw.solve(Y[l],c,xest) != 0) nfail++;
+				}
+				catch (int) {nfail++;}
+				its+=ipw.iter;
+				snrsum+=snr(X[l],xest);
+			}
+			Doub t=(double)(clock() - tStart)/CLOCKS_PER_SEC/count;
+			if (w == 0) {
+				itscold=its;
+				t_warm=t;
+			}
+			printf("       %s %s  %.1f iterations/vector, %.6fs/vector, failures %d, mean SNR %.2f dB",
+				v ? "Mehrotra," : "Centering,", w ? "warm:" : "cold:", (Doub)its/count, t, nfail,
+				snrsum/count);
+			if (w == 1)
+				printf(", %d restarts, %.1f%% iterations saved, speedup %.2f",ipw.nrestart,
+					100.0*(itscold-its)/itscold,t_warm/t);
+			printf("\n");
+		}
+	}
+	printf("\n");
+	return 0;
+}
+
+//end of file intptstream.cpp
@@ -0,0 +1,137 @@
+/*
+ Begin ldlbench.cpp
+ */
+/*
+ Timing of the numeric factorization of A.D.A^T by NRldl, row by row with ldl_numeric
+ and by supernodes (NRldl::supernodal), for random A with M = N/4 and several densities;
+ every column of A has at least one nonzero. The number of supernodes, the time per
+ factorization and the largest relative difference of the solutions of A.D.A^T y = 1
+ are printed. Build with -fopenmp to factor independent subtrees in parallel.
+ A second table compares, for the sparsest and the dense A, the solve with k random
+ right-hand sides at once (NRldl::solve with matrices) with k single solves.
+
+ Usage: ldlbench [N [reps [seed]]]   (default 4000 5 1)
+ */
+#include "nr3.h"
+#include "sparse.h"
+#include "NRldl.h"
+
+void init_A(Int M, Int N, Doub dens, NRsparseMat &a)
+// Random A in compressed column storage, entry (j mod M, j) and every other entry with
+// probability dens nonzero
+{
+	Int i,j,nz=0;
+	vector<Int> ri;
+	vector<Doub> v;
+	VecInt cp(N+1);
+	for (j=0;j<N;j++) {
+		cp[j]=nz;
+		for (i=0;i<M;i++)
+			if (i == j%M || (Doub)rand()/RAND_MAX < dens) {
+				ri.push_back(i);
+				v.push_back((Doub)rand()/RAND_MAX);
+				nz++;
+			}
+	}
+	cp[N]=nz;
+	a=NRsparseMat(M,N,nz);
+	for (j=0;j<=N;j++) a.col_ptr[j]=cp[j];
+	for (i=0;i<nz;i++) {
+		a.row_ind[i]=ri[i];
+		a.val[i]=v[i];
+	}
+}
+
+Doub wtime()
+// Wall clock seconds; clock() would add up the time of all threads
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec+1.0e-9*ts.tv_nsec;
+}
+
+Int main(int argc, char **argv) {
+
+	const Int NDENS=5;
+	const Doub dens[NDENS]={0.001,0.002,0.005,0.01,1.0};
+	const Int NK=5;
+	const Int nrhs[NK]={1,4,8,16,64};
+	Int i,j,r,c,v,l,M,N=4000,reps=5,nsuper=0;
+	Doub tStart,t[2],diff;
+
+	if (argc > 1) N=atoi(argv[1]);
+	if (argc > 2) reps=atoi(argv[2]);
+	srand(argc > 3 ? atoi(argv[3]) : 1);
+	M=N/4;
+
+	printf("Running program InteriorPoints LDL benchmark, N = %d, M = %d, s per factorization\n\n", N,M);
+	printf("   dens |     nnz(L) supernodes | ldl_numeric  supernodal | max rel diff\n");
+	for (c=0;c<NDENS;c++) {
+		NRsparseMat A;
+		init_A(M,N,dens[c],A);
+		NRsparseMat At=A.transpose();
+		ADAT adat(A,At);
+		VecDoub D(N),rhs(M,1.0),y[2]={VecDoub(M),VecDoub(M)};
+		for (j=0;j<N;j++) D[j]=exp(10.0*((Doub)rand()/RAND_MAX-0.5));
+		adat.updateD(D);
+		Int lnz=0;
+		for (v=0;v<2;v++) {
+			NRldl solver(adat.ref());
+			solver.verbose=false;
+			solver.supernodal=(v == 1);
+			solver.order();
+			tStart=wtime();
+			for (r=0;r<reps;r++)
+				solver.factorize();
+			t[v]=(wtime()-tStart)/reps;
+			solver.solve(y[v],rhs);
+			lnz=solver.lnz;
+			if (v == 1) nsuper=solver.nsuper;
+		}
+		diff=0.0;
+		for (i=0;i<M;i++)
+			diff=MAX(diff,abs(y[1][i]-y[0][i])/abs(y[0][i]));
+		printf("  %5.3f | %10d %10d |  %10.6f  %10.6f | %8.1e\n", dens[c],lnz,nsuper,t[0],t[1],diff);
+	}
+
+	printf("\n   dens |    k | single solves  block solve |  speedup | max diff\n");
+	for (c=0;c<NDENS;c+=NDENS-1) {
+		NRsparseMat A;
+		init_A(M,N,dens[c],A);
+		NRsparseMat At=A.transpose();
+		ADAT adat(A,At);
+		VecDoub D(N);
+		for (j=0;j<N;j++) D[j]=exp(10.0*((Doub)rand()/RAND_MAX-0.5));
+		adat.updateD(D);
+		NRldl solver(adat.ref());
+		solver.verbose=false;
+		solver.order();
+		solver.factorize();
+		for (Int ik=0;ik<NK;ik++) {
+			Int k=nrhs[ik], sreps=MAX(1,200/k);
+			MatDoub B(M,k),X(M,k);
+			VecDoub b(M),x(M);
+			for (i=0;i<M;i++)
+				for (l=0;l<k;l++) B[i][l]=(Doub)rand()/RAND_MAX;
+			tStart=wtime();
+			for (r=0;r<sreps;r++)
+				for (l=0;l<k;l++) {
+					for (i=0;i<M;i++) b[i]=B[i][l];
+					solver.solve(x,b);
+				}
+			t[0]=(wtime()-tStart)/sreps;
+			tStart=wtime();
+			for (r=0;r<sreps;r++)
+				solver.solve(X,B);
+			t[1]=(wtime()-tStart)/sreps;
+			diff=0.0;
+			for (i=0;i<M;i++)
+				diff=MAX(diff,abs(X[i][k-1]-x[i]));
+			printf("  %5.3f | %4d |   %10.6f   %10.6f | %8.2f | %8.1e\n", dens[c],k,t[0],t[1],t[0]/t[1],diff);
+		}
+	}
+	printf("\n");
+	return 0;
+}
+
+//end of file ldlbench.cpp
@@ -0,0 +1,120 @@
+struct LinOp {
+// An m x n linear operator that is only ever applied, for the matrix-free solvers: the
+// products y = alpha op(A) x + beta y and the diagonal of A.D.A^T for a diagonal D,
+// which is what the Jacobi preconditioner of CGADAT needs. MatVec is the one for an
+// explicit A; fastop.h has subsampled fast transforms that store no matrix at all.
+	Int m,n;
+	LinOp(Int mm, Int nn) : m(mm), n(nn) {}
+	virtual void ax(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const=0;
+	virtual void atx(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const=0;
+	virtual void adatdiag(const VecDoub &D, VecDoub &s) const=0;
+	virtual ~LinOp() {}
+};
+
+struct MatVec : LinOp {
+// Products with A and A^T for the interior point method, y = alpha op(A) x + beta y. Both
+// are done as gathers, one dot product per component of y, so the components can be
+// shared out among threads without races and every inner loop is a stride one dot
+// product the compiler can vectorize: A x runs over the columns of at (the rows of A,
+// i.e. A in compressed row storage) and A^T x over the columns of a. If A is at least
+// densefrac full, the zeros are not worth their indices and A is kept as a dense row
+// major array Ar instead; A x is then a dot product per row of Ar and A^T x is done in
+// panels of MATVEC_JB columns, each panel an independent sum of scaled rows of Ar.
+// Parallel loops use OpenMP when compiled with it and stay serial below MATVEC_PAR
+// multiply-adds, where starting threads costs more than it saves. Every component is
+// summed in the same order whatever the number of threads.
+	const NRsparseMat &a,&at;
+	Int ld;
+	Bool dense;
+	VecDoub Ar;			// dense A, row major, m x ld, if dense
+	MatVec(const NRsparseMat &A, const NRsparseMat &AT, Doub densefrac);
+	void ax(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const;
+	void atx(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const;
+	void adatdiag(const VecDoub &D, VecDoub &s) const;
+};
+
+static const Int MATVEC_JB=512;		// columns per panel of the dense A^T x
+static const Int MATVEC_PAR=65536;	// smallest product done in parallel
+
+MatVec::MatVec(const NRsparseMat &A, const NRsparseMat &AT, Doub densefrac) :
+	LinOp(A.nrows,A.ncols), a(A), at(AT), ld((A.ncols+3)/4*4), dense(A.col_ptr[A.ncols] >= densefrac*m*n) {
+	if (dense) {
+		Ar.assign(m*ld,0.0);
+		for (Int j=0;j<n;j++)
+			for (Int i=A.col_ptr[j];i<A.col_ptr[j+1];i++)
+				Ar[A.row_ind[i]*ld+j]+=A.val[i];
+	}
+}
+
+void MatVec::ax(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const
+// y = alpha A x + beta y
+{
+	if (!dense) {
+		at.atxpy(alpha,x,beta,y);
+		return;
+	}
+	const Doub *ar=&Ar[0], *xp=&x[0];
+	Doub *yp=&y[0];
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if ((Doub)m*n > MATVEC_PAR)
+#endif
+	for (Int i=0;i<m;i++) {
+		const Doub *r=ar+(size_t)i*ld;
+		Doub t=0.0;
+#ifdef _OPENMP
+#pragma omp simd reduction(+:t)
+#endif
+		for (Int j=0;j<n;j++)
+			t+=r[j]*xp[j];
+		yp[i]=(beta == 0.0 ? alpha*t : alpha*t+beta*yp[i]);
+	}
+}
+
+void MatVec::atx(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const
+// y = alpha A^T x + beta y
+{
+	if (!dense) {
+		a.atxpy(alpha,x,beta,y);
+		return;
+	}
+	const Doub *ar=&Ar[0], *xp=&x[0];
+	Doub *yp=&y[0];
+	Int npanel=(n+MATVEC_JB-1)/MATVEC_JB;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if ((Doub)m*n > MATVEC_PAR)
+#endif
+	for (Int p=0;p<npanel;p++) {
+		Int j,j0=p*MATVEC_JB, j1=MIN(n,j0+MATVEC_JB);
+		if (beta == 0.0)
+			for (j=j0;j<j1;j++)
+				yp[j]=0.0;
+		else if (beta != 1.0)
+			for (j=j0;j<j1;j++)
+				yp[j]*=beta;
+		for (Int i=0;i<m;i++) {
+			const Doub *r=ar+(size_t)i*ld;
+			Doub s=alpha*xp[i];
+			if (s == 0.0)
+				continue;
+#ifdef _OPENMP
+#pragma omp simd
+#endif
+			for (j=j0;j<j1;j++)
+				yp[j]+=s*r[j];
+		}
+	}
+}
+
+void MatVec::adatdiag(const VecDoub &D, VecDoub &s) const
+// s_i = sum_j A_ij^2 D_j, from the rows of A (the columns of at)
+{
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (at.col_ptr[m] > MATVEC_PAR)
+#endif
+	for (Int i=0;i<m;i++) {
+		Doub t=0.0;
+		for (Int k=at.col_ptr[i];k<at.col_ptr[i+1];k++)
+			t+=SQR(at.val[k])*D[at.row_ind[k]];
+		s[i]=t;
+	}
+}
@@ -0,0 +1,122 @@
+/*
+ Begin matvecbench.cpp
+ */
+/*
+ Timing of the products with A and A^T of the interior point method. Every iteration of
+ intpt multiplies by A twice and by A^T twice; this is timed for a dense random Phi,
+ M = N/4, with
+	scatter	NRsparseMat::ax on A and on its transpose, as intpt did originally
+	gather	MatVec on the compressed column and compressed row views of A
+	dense	MatVec on the dense row major copy of A
+ and the largest difference from the scatter results is printed as a check. For N up
+ to nsolve an Intpt solve of a K-sparse x, K = N/64, is timed as well. Build with
+ -fopenmp to run the gathers on all cores.
+
+ Usage: matvecbench [nmax [nsolve [reps]]]   (default 16384 4096 10)
+ */
+#include "nr3.h"
+#include "sparse.h"
+#include "NRldl.h"
+#include "intpt.h"
+
+void init_Phi(Int M, Int N, NRsparseMat &a)
+// Dense random Phi in compressed column storage
+{
+	Int i,j;
+	a=NRsparseMat(M,N,M*N);
+	for (j=0;j<N;j++) {
+		a.col_ptr[j]=j*M;
+		for (i=0;i<M;i++) {
+			a.row_ind[j*M+i]=i;
+			a.val[j*M+i]=(Doub)rand()/RAND_MAX;
+		}
+	}
+	a.col_ptr[N]=M*N;
+}
+
+Doub wtime()
+// Wall clock seconds; clock() would add up the time of all threads
+{
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC,&ts);
+	return ts.tv_sec+1.0e-9*ts.tv_nsec;
+}
+
+Doub maxdiff(VecDoub_I &x, VecDoub_I &y)
+{
+	Doub d=0.0;
+	for (Int i=0;i<x.size();i++)
+		d=MAX(d,abs(x[i]-y[i]));
+	return d;
+}
+
+Int main(int argc, char **argv) {
+
+	Int i,j,r,M,N,K,nmax=16384,nsolve=4096,reps=10;
+	Doub t[3],tStart;
+
+	if (argc > 1) nmax=atoi(argv[1]);
+	if (argc > 2) nsolve=atoi(argv[2]);
+	if (argc > 3) reps=atoi(argv[3]);
+	srand(1);
+
+	printf("Running program InteriorPoints mat-vec benchmark, s per 2 A x + 2 A^T y\n\n");
+	printf("      N     M |    scatter     gather      dense |  max diff | intpt s/solve\n");
+	for (N=1024;N<=nmax;N*=2) {
+		M=N/4;
+		NRsparseMat A;
+		init_Phi(M,N,A);
+		NRsparseMat At=A.transpose();
+		VecDoub x(N),y(M),ax(M),aty(N),ax1(M),aty1(N),ax2(M),aty2(N);
+		for (j=0;j<N;j++) x[j]=(Doub)rand()/RAND_MAX;
+		for (i=0;i<M;i++) y[i]=(Doub)rand()/RAND_MAX;
+
+		tStart = wtime();
+		for (r=0;r<reps;r++) {
+			ax=A.ax(x);
+			aty=At.ax(y);
+			ax=A.ax(x);
+			aty=At.ax(y);
+		}
+		t[0] = (wtime() - tStart)/reps;
+		Doub diff=0.0;
+		for (Int v=1;v<=2;v++) {
+			MatVec mv(A,At,v == 1 ? 2.0 : 0.0);
+			VecDoub &bx=(v == 1 ? ax1 : ax2), &by=(v == 1 ? aty1 : aty2);
+			tStart = wtime();
+			for (r=0;r<reps;r++) {
+				mv.ax(1.0,x,0.0,bx);
+				mv.atx(1.0,y,0.0,by);
+				mv.ax(1.0,x,0.0,bx);
+				mv.atx(1.0,y,0.0,by);
+			}
+			t[v] = (wtime() - tStart)/reps;
+			diff=MAX(diff,MAX(maxdiff(ax,bx),maxdiff(aty,by)));
+		}
+		printf("  %5d %5d | %10.6f %10.6f %10.6f | %9.2e |", N,M,t[0],t[1],t[2],diff);
+		if (N <= nsolve) {
+			K=MAX(N/64,1);
+			VecDoub xs(N,0.0),c(N,1.0),xest(N);
+			for (i=0;i<K;) {
+				j=rand()%N;
+				if (xs[j] == 0.0) {
+					xs[j]=(Doub)rand()/RAND_MAX+1e-3;
+					i++;
+				}
+			}
+			VecDoub b=A.ax(xs);
+			Intpt ip(A,false);
+			tStart = wtime();
+			try {
+				ip.solve(b,c,xest);
+			}
+			catch (int) {}
+			printf(" %10.3f (%d its)", wtime() - tStart, ip.iter);
+		}
+		printf("\n");
+	}
+	printf("\n");
+	return 0;
+}
+
+//end of file matvecbench.cpp
@@ -20,6 +20,10 @@
 #include <fcntl.h>
 #include <string.h>
 #include <ctype.h>
+#include <new>
+#ifdef _MSC_VER
+#include <malloc.h>
+#endif
 
 using namespace std;
 
@@ -94,6 +98,64 @@ void NRcatch(NRerror err) {
 
 // Vector and Matrix Classes
 
+// NRvector and NRmatrix keep their elements in storage aligned to NR_ALIGN bytes, so
+// that rows and vectors start on a cache line and vector loads do not straddle lines.
+// Storage is never shrunk: resize(), assign() and assignment reuse it whenever it is
+// large enough, and with C++11 a temporary (a vector returned by value, say) is moved
+// instead of copied. nralloc_count() is the number of blocks allocated so far, which
+// lets a program check that a loop does not allocate, and nralloc_bytes() their size.
+
+#ifndef NR_ALIGN
+#define NR_ALIGN 64	// alignment of NRvector and NRmatrix storage, a power of 2
+#endif
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define _NRMOVE_ 1	// move constructors and move assignment
+#endif
+
+inline size_t &nralloc_count()
+{
+	static size_t count=0;
+	return count;
+}
+
+inline size_t &nralloc_bytes()
+{
+	static size_t bytes=0;
+	return bytes;
+}
+
+inline void *nralloc(size_t bytes)
+// bytes of storage aligned to NR_ALIGN
+{
+	void *p;
+	size_t &count=nralloc_count(), &total=nralloc_bytes();
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+	count++;
+#ifdef _OPENMP
+#pragma omp atomic
+#endif
+	total+=bytes;
+#ifdef _MSC_VER
+	p=_aligned_malloc(bytes,NR_ALIGN);
+#else
+	if (posix_memalign(&p,NR_ALIGN,bytes) != 0) p=NULL;
+#endif
+	if (p == NULL) throw("allocation failure in nralloc");
+	return p;
+}
+
+inline void nrfree(void *p)
+{
+#ifdef _MSC_VER
+	_aligned_free(p);
+#else
+	free(p);
+#endif
+}
+
 #ifdef _USESTDVECTOR_
 #define NRvector vector
 #else
@@ -102,7 +164,10 @@ template <class T>
 class NRvector {
 private:
 	int nn;	// size of array. upper index is nn-1
+	int cap;	// number of elements allocated, nn <= cap
 	T *v;
+	void allocate(int n);	// storage for n elements, after release()
+	void release();
 public:
 	NRvector();
 	explicit NRvector(int n);		// Zero-based array
@@ -110,11 +175,16 @@ public:
 	NRvector(int n, const T *a);	// Initialize to array
 	NRvector(const NRvector &rhs);	// Copy constructor
 	NRvector & operator=(const NRvector &rhs);	//assignment
+#ifdef _NRMOVE_
+	NRvector(NRvector &&rhs);	// Move constructor, leaves rhs empty
+	NRvector & operator=(NRvector &&rhs);	// move assignment
+#endif
 	typedef T value_type; // make T available externally
 	inline T & operator[](const int i);	//i'th element
 	inline const T & operator[](const int i) const;
 	inline int size() const;
-	void resize(int newn); // resize (contents not preserved)
+	inline int capacity() const;
+	void resize(int newn); // resize (contents not preserved if newn > capacity)
 	void assign(int newn, const T &a); // resize and assign a constant value
 	~NRvector();
 };
@@ -122,26 +192,51 @@ public:
 // NRvector definitions
 
 template <class T>
-NRvector<T>::NRvector() : nn(0), v(NULL) {}
+void NRvector<T>::allocate(int n)
+{
+	cap = n > 0 ? n : 0;
+	v = cap > 0 ? (T *)nralloc(sizeof(T)*cap) : NULL;
+	for (int i=0; i<cap; i++) new (v+i) T;
+}
+
+template <class T>
+void NRvector<T>::release()
+{
+	if (v != NULL) {
+		for (int i=0; i<cap; i++) v[i].~T();
+		nrfree(v);
+	}
+	v = NULL;
+	cap = 0;
+}
+
+template <class T>
+NRvector<T>::NRvector() : nn(0), cap(0), v(NULL) {}
 
 template <class T>
-NRvector<T>::NRvector(int n) : nn(n), v(n>0 ? new T[n] : NULL) {}
+NRvector<T>::NRvector(int n) : nn(n)
+{
+	allocate(n);
+}
 
 template <class T>
-NRvector<T>::NRvector(int n, const T& a) : nn(n), v(n>0 ? new T[n] : NULL)
+NRvector<T>::NRvector(int n, const T& a) : nn(n)
 {
+	allocate(n);
 	for(int i=0; i<n; i++) v[i] = a;
 }
 
 template <class T>
-NRvector<T>::NRvector(int n, const T *a) : nn(n), v(n>0 ? new T[n] : NULL)
+NRvector<T>::NRvector(int n, const T *a) : nn(n)
 {
+	allocate(n);
 	for(int i=0; i<n; i++) v[i] = *a++;
 }
 
 template <class T>
-NRvector<T>::NRvector(const NRvector<T> &rhs) : nn(rhs.nn), v(nn>0 ? new T[nn] : NULL)
+NRvector<T>::NRvector(const NRvector<T> &rhs) : nn(rhs.nn)
 {
+	allocate(nn);
 	for(int i=0; i<nn; i++) v[i] = rhs[i];
 }
 
@@ -153,17 +248,41 @@ NRvector<T> & NRvector<T>::operator=(const NRvector<T> &rhs)
 {
 	if (this != &rhs)
 	{
-		if (nn != rhs.nn) {
-			if (v != NULL) delete [] (v);
-			nn=rhs.nn;
-			v= nn>0 ? new T[nn] : NULL;
+		if (rhs.nn > cap) {
+			release();
+			allocate(rhs.nn);
 		}
+		nn=rhs.nn;
 		for (int i=0; i<nn; i++)
 			v[i]=rhs[i];
 	}
 	return *this;
 }
 
+#ifdef _NRMOVE_
+template <class T>
+NRvector<T>::NRvector(NRvector<T> &&rhs) : nn(rhs.nn), cap(rhs.cap), v(rhs.v)
+{
+	rhs.nn = rhs.cap = 0;
+	rhs.v = NULL;
+}
+
+template <class T>
+NRvector<T> & NRvector<T>::operator=(NRvector<T> &&rhs)
+{
+	if (this != &rhs)
+	{
+		release();
+		nn=rhs.nn;
+		cap=rhs.cap;
+		v=rhs.v;
+		rhs.nn = rhs.cap = 0;
+		rhs.v = NULL;
+	}
+	return *this;
+}
+#endif
+
 template <class T>
 inline T & NRvector<T>::operator[](const int i)	//subscripting
 {
@@ -192,31 +311,33 @@ inline int NRvector<T>::size() const
 	return nn;
 }
 
+template <class T>
+inline int NRvector<T>::capacity() const
+{
+	return cap;
+}
+
 template <class T>
 void NRvector<T>::resize(int newn)
 {
-	if (newn != nn) {
-		if (v != NULL) delete[] (v);
-		nn = newn;
-		v = nn > 0 ? new T[nn] : NULL;
+	if (newn > cap) {
+		release();
+		allocate(newn);
 	}
+	nn = newn > 0 ? newn : 0;
 }
 
 template <class T>
 void NRvector<T>::assign(int newn, const T& a)
 {
-	if (newn != nn) {
-		if (v != NULL) delete[] (v);
-		nn = newn;
-		v = nn > 0 ? new T[nn] : NULL;
-	}
+	resize(newn);
 	for (int i=0;i<nn;i++) v[i] = a;
 }
 
 template <class T>
 NRvector<T>::~NRvector()
 {
-	if (v != NULL) delete[] (v);
+	release();
 }
 
 // end of NRvector definitions
@@ -228,7 +349,13 @@ class NRmatrix {
 private:
 	int nn;
 	int mm;
+	int cap;	// elements allocated, nn*mm <= cap
+	int rcap;	// row pointers allocated, nn <= rcap
+	T *d;	// the elements, row after row
 	T **v;
+	void allocate(int n, int m);	// storage for n x m elements, after release()
+	void release();
+	void setrows();	// row pointers for the current nn and mm
 public:
 	NRmatrix();
 	NRmatrix(int n, int m);			// Zero-based array
@@ -236,6 +363,10 @@ public:
 	NRmatrix(int n, int m, const T *a);	// Initialize to array
 	NRmatrix(const NRmatrix &rhs);		// Copy constructor
 	NRmatrix & operator=(const NRmatrix &rhs);	//assignment
+#ifdef _NRMOVE_
+	NRmatrix(NRmatrix &&rhs);		// Move constructor, leaves rhs empty
+	NRmatrix & operator=(NRmatrix &&rhs);	// move assignment
+#endif
 	typedef T value_type; // make T available externally
 	inline T* operator[](const int i);	//subscripting: pointer to row i
 	inline const T* operator[](const int i) const;
@@ -247,40 +378,70 @@ public:
 };
 
 template <class T>
-NRmatrix<T>::NRmatrix() : nn(0), mm(0), v(NULL) {}
+void NRmatrix<T>::allocate(int n, int m)
+{
+	int i;
+	rcap = n > 0 ? n : 0;
+	cap = n > 0 && m > 0 ? n*m : 0;
+	v = rcap > 0 ? (T **)nralloc(sizeof(T*)*rcap) : NULL;
+	d = cap > 0 ? (T *)nralloc(sizeof(T)*cap) : NULL;
+	for (i=0; i<cap; i++) new (d+i) T;
+}
+
+template <class T>
+void NRmatrix<T>::release()
+{
+	if (d != NULL) {
+		for (int i=0; i<cap; i++) d[i].~T();
+		nrfree(d);
+	}
+	if (v != NULL) nrfree(v);
+	d = NULL;
+	v = NULL;
+	cap = rcap = 0;
+}
+
+template <class T>
+void NRmatrix<T>::setrows()
+{
+	if (v) v[0] = nn*mm > 0 ? d : NULL;
+	for (int i=1; i<nn; i++) v[i] = v[i-1] + mm;
+}
+
+template <class T>
+NRmatrix<T>::NRmatrix() : nn(0), mm(0), cap(0), rcap(0), d(NULL), v(NULL) {}
 
 template <class T>
-NRmatrix<T>::NRmatrix(int n, int m) : nn(n), mm(m), v(n>0 ? new T*[n] : NULL)
+NRmatrix<T>::NRmatrix(int n, int m) : nn(n), mm(m)
 {
-	int i,nel=m*n;
-	if (v) v[0] = nel>0 ? new T[nel] : NULL;
-	for (i=1;i<n;i++) v[i] = v[i-1] + m;
+	allocate(n,m);
+	setrows();
 }
 
 template <class T>
-NRmatrix<T>::NRmatrix(int n, int m, const T &a) : nn(n), mm(m), v(n>0 ? new T*[n] : NULL)
+NRmatrix<T>::NRmatrix(int n, int m, const T &a) : nn(n), mm(m)
 {
-	int i,j,nel=m*n;
-	if (v) v[0] = nel>0 ? new T[nel] : NULL;
-	for (i=1; i< n; i++) v[i] = v[i-1] + m;
+	int i,j;
+	allocate(n,m);
+	setrows();
 	for (i=0; i< n; i++) for (j=0; j<m; j++) v[i][j] = a;
 }
 
 template <class T>
-NRmatrix<T>::NRmatrix(int n, int m, const T *a) : nn(n), mm(m), v(n>0 ? new T*[n] : NULL)
+NRmatrix<T>::NRmatrix(int n, int m, const T *a) : nn(n), mm(m)
 {
-	int i,j,nel=m*n;
-	if (v) v[0] = nel>0 ? new T[nel] : NULL;
-	for (i=1; i< n; i++) v[i] = v[i-1] + m;
+	int i,j;
+	allocate(n,m);
+	setrows();
 	for (i=0; i< n; i++) for (j=0; j<m; j++) v[i][j] = *a++;
 }
 
 template <class T>
-NRmatrix<T>::NRmatrix(const NRmatrix &rhs) : nn(rhs.nn), mm(rhs.mm), v(nn>0 ? new T*[nn] : NULL)
+NRmatrix<T>::NRmatrix(const NRmatrix &rhs) : nn(rhs.nn), mm(rhs.mm)
 {
-	int i,j,nel=mm*nn;
-	if (v) v[0] = nel>0 ? new T[nel] : NULL;
-	for (i=1; i< nn; i++) v[i] = v[i-1] + mm;
+	int i,j;
+	allocate(nn,mm);
+	setrows();
 	for (i=0; i< nn; i++) for (j=0; j<mm; j++) v[i][j] = rhs[i][j];
 }
 
@@ -291,24 +452,42 @@ NRmatrix<T> & NRmatrix<T>::operator=(const NRmatrix<T> &rhs)
 //		has been resized to match the size of rhs
 {
 	if (this != &rhs) {
-		int i,j,nel;
-		if (nn != rhs.nn || mm != rhs.mm) {
-			if (v != NULL) {
-				delete[] (v[0]);
-				delete[] (v);
-			}
-			nn=rhs.nn;
-			mm=rhs.mm;
-			v = nn>0 ? new T*[nn] : NULL;
-			nel = mm*nn;
-			if (v) v[0] = nel>0 ? new T[nel] : NULL;
-			for (i=1; i< nn; i++) v[i] = v[i-1] + mm;
-		}
+		int i,j;
+		resize(rhs.nn,rhs.mm);
 		for (i=0; i< nn; i++) for (j=0; j<mm; j++) v[i][j] = rhs[i][j];
 	}
 	return *this;
 }
 
+#ifdef _NRMOVE_
+template <class T>
+NRmatrix<T>::NRmatrix(NRmatrix<T> &&rhs) : nn(rhs.nn), mm(rhs.mm), cap(rhs.cap),
+	rcap(rhs.rcap), d(rhs.d), v(rhs.v)
+{
+	rhs.nn = rhs.mm = rhs.cap = rhs.rcap = 0;
+	rhs.d = NULL;
+	rhs.v = NULL;
+}
+
+template <class T>
+NRmatrix<T> & NRmatrix<T>::operator=(NRmatrix<T> &&rhs)
+{
+	if (this != &rhs) {
+		release();
+		nn=rhs.nn;
+		mm=rhs.mm;
+		cap=rhs.cap;
+		rcap=rhs.rcap;
+		d=rhs.d;
+		v=rhs.v;
+		rhs.nn = rhs.mm = rhs.cap = rhs.rcap = 0;
+		rhs.d = NULL;
+		rhs.v = NULL;
+	}
+	return *this;
+}
+#endif
+
 template <class T>
 inline T* NRmatrix<T>::operator[](const int i)	//subscripting: pointer to row i
 {
@@ -346,47 +525,29 @@ inline int NRmatrix<T>::ncols() const
 template <class T>
 void NRmatrix<T>::resize(int newn, int newm)
 {
-	int i,nel;
-	if (newn != nn || newm != mm) {
-		if (v != NULL) {
-			delete[] (v[0]);
-			delete[] (v);
-		}
-		nn = newn;
-		mm = newm;
-		v = nn>0 ? new T*[nn] : NULL;
-		nel = mm*nn;
-		if (v) v[0] = nel>0 ? new T[nel] : NULL;
-		for (i=1; i< nn; i++) v[i] = v[i-1] + mm;
+	if (newn < 0) newn = 0;
+	if (newm < 0) newm = 0;
+	if (newn > rcap || newn*newm > cap) {
+		release();
+		allocate(newn,newm);
 	}
+	nn = newn;
+	mm = newm;
+	setrows();
 }
 
 template <class T>
 void NRmatrix<T>::assign(int newn, int newm, const T& a)
 {
-	int i,j,nel;
-	if (newn != nn || newm != mm) {
-		if (v != NULL) {
-			delete[] (v[0]);
-			delete[] (v);
-		}
-		nn = newn;
-		mm = newm;
-		v = nn>0 ? new T*[nn] : NULL;
-		nel = mm*nn;
-		if (v) v[0] = nel>0 ? new T[nel] : NULL;
-		for (i=1; i< nn; i++) v[i] = v[i-1] + mm;
-	}
+	int i,j;
+	resize(newn,newm);
 	for (i=0; i< nn; i++) for (j=0; j<mm; j++) v[i][j] = a;
 }
 
 template <class T>
 NRmatrix<T>::~NRmatrix()
 {
-	if (v != NULL) {
-		delete[] (v[0]);
-		delete[] (v);
-	}
+	release();
 }
 
 template <class T>
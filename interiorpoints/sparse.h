@@ -1,4 +1,10 @@
 #include "sort.h"
+#ifdef _OPENMP
+#pragma push_macro("throw")	// nr3.h's throw() would break omp.h
+#undef throw
+#include <omp.h>
+#pragma pop_macro("throw")
+#endif
 
 struct NRsparseCol							//sparse vector data structure
 {
@@ -33,6 +39,10 @@ struct NRsparseMat							//sparse matrix data structure for compressed column st
 	NRsparseMat(Int m,Int n,Int nnvals);				//constructor. initializes vector to zero
 	VecDoub ax(const VecDoub &x) const;				//multiply A by a vector x[0…ncols-1]
 	VecDoub atx(const VecDoub &x) const;				//multiply A transpose by a vector x[0…nrows-1]
+	void ax_into(const VecDoub &x, VecDoub &y) const;		//y = A x into existing storage
+	void atx_into(const VecDoub &x, VecDoub &y) const;		//y = A^T x into existing storage
+	void axpy(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const;	//y = alpha A x + beta y
+	void atxpy(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const;	//y = alpha A^T x + beta y
 	NRsparseMat transpose() const;					//form A transpose
 };
 NRsparseMat::NRsparseMat() : nrows(0),ncols(0),nvals(0),col_ptr(),
@@ -40,21 +50,56 @@ NRsparseMat::NRsparseMat() : nrows(0),ncols(0),nvals(0),col_ptr(),
 NRsparseMat::NRsparseMat(Int m,Int n,Int nnvals) : nrows(m),ncols(n),
 	nvals(nnvals),col_ptr(n+1,0),row_ind(nnvals,0),val(nnvals,0.0) {}
 VecDoub NRsparseMat::ax(const VecDoub &x) const {
-	VecDoub y(nrows,0.0);
+	VecDoub y(nrows);
+	ax_into(x,y);
+	return y;
+}
+VecDoub NRsparseMat::atx(const VecDoub &x) const {
+	VecDoub y(ncols);
+	atx_into(x,y);
+	return y;
+}
+void NRsparseMat::ax_into(const VecDoub &x, VecDoub &y) const {
+	for (Int i=0;i<nrows;i++)
+		y[i]=0.0;
 	for (Int j=0;j<ncols;j++) {
 		for (Int i=col_ptr[j];i<col_ptr[j+1];i++)
 			y[row_ind[i]] += val[i]*x[j];
 	}
-	return y;
 }
-VecDoub NRsparseMat::atx(const VecDoub &x) const {
-	VecDoub y(ncols);
+void NRsparseMat::atx_into(const VecDoub &x, VecDoub &y) const {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (col_ptr[ncols] > 65536)	//a gather: no races
+#endif
 	for (Int i=0;i<ncols;i++) {
 		y[i]=0.0;
 		for (Int j=col_ptr[i];j<col_ptr[i+1];j++)
 			y[i] += val[j]*x[row_ind[j]];
 	}
-	return y;
+}
+void NRsparseMat::axpy(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const {
+	if (beta == 0.0)
+		for (Int i=0;i<nrows;i++)
+			y[i]=0.0;
+	else if (beta != 1.0)
+		for (Int i=0;i<nrows;i++)
+			y[i]*=beta;
+	for (Int j=0;j<ncols;j++) {
+		Doub t=alpha*x[j];
+		for (Int i=col_ptr[j];i<col_ptr[j+1];i++)
+			y[row_ind[i]] += val[i]*t;
+	}
+}
+void NRsparseMat::atxpy(Doub alpha, const VecDoub &x, Doub beta, VecDoub &y) const {
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static) if (col_ptr[ncols] > 65536)
+#endif
+	for (Int i=0;i<ncols;i++) {
+		Doub t=0.0;
+		for (Int j=col_ptr[i];j<col_ptr[i+1];j++)
+			t += val[j]*x[row_ind[j]];
+		y[i]=(beta == 0.0 ? alpha*t : alpha*t+beta*y[i]);
+	}
 }
 NRsparseMat NRsparseMat::transpose() const {
 	Int i,j,k,index,m=nrows,n=ncols;
@@ -79,16 +124,26 @@ NRsparseMat NRsparseMat::transpose() const {
 		}
 	return at;
 }
+#ifndef ADAT_MAXCONTRIB
+#define ADAT_MAXCONTRIB 50000000					//largest contribution index kept by ADAT
+#endif
+
 struct ADAT {
 	const NRsparseMat &a,&at;
 	NRsparseMat *adat;
+	VecDoub temp,temp2;						//workspace of updateD_scatter
+	VecInt cptr,contrib;						//contribution index, see index()
+	VecDoub ad;							//A_ik D_k, workspace of updateD
 
 	ADAT(const NRsparseMat &A,const NRsparseMat &AT);
+	void index();
 	void updateD(const VecDoub &D);
+	void updateD_scatter(const VecDoub &D);
 	NRsparseMat &ref();
 	~ADAT();
 };
-ADAT::ADAT(const NRsparseMat &A,const NRsparseMat &AT) : a(A), at(AT) {
+ADAT::ADAT(const NRsparseMat &A,const NRsparseMat &AT) : a(A), at(AT),
+	temp(A.ncols), temp2(A.nrows,0.0) {
 	Int h,i,j,k,l,nvals,m=AT.ncols;
 	VecInt done(m);
 	for (i=0;i<m;i++)
@@ -135,10 +190,102 @@ ADAT::ADAT(const NRsparseMat &A,const NRsparseMat &AT) : a(A), at(AT) {
 				adat->row_ind[i+k]=col[k];
 		}
 	}
+#ifdef _OPENMP
+	if (omp_get_max_threads() > 1)					//the gather only pays off in parallel
+		index();
+#endif
+}
+void ADAT::index()
+/*
+ Every entry of A.D.A^T is a sum of products A_ik D_k A_hk. For entry s of adat->val the
+ products are listed in contrib[2*cptr[s]..2*cptr[s+1]-1] as pairs of positions in
+ at.val, of A_ik and A_hk, in increasing k as updateD_scatter adds them, so both give
+ the same bits. Both positions of a product lie in the rows i and h of A, which at
+ holds in compressed row form, so the gather of an entry sweeps forward through two rows.
+ The index has sum_k (entries of column k of A)^2 pairs; if that exceeds
+ ADAT_MAXCONTRIB it is not built and updateD_scatter is used instead. On one core the
+ scatter is as fast or faster, so the constructor only builds the index for OpenMP
+ with more than one thread.
+*/
+{
+	Int h,i,j,k,l,s,m=a.nrows,n=a.ncols,nz=adat->col_ptr[m];
+	Doub total=0.0;
+	for (k=0;k<n;k++)
+		total+=SQR((Doub)(a.col_ptr[k+1]-a.col_ptr[k]));
+	if (total > ADAT_MAXCONTRIB)
+		return;
+	VecInt apos(a.col_ptr[n]),next(MAX(m,nz)),slot(m);
+	for (i=0;i<m;i++)
+		next[i]=at.col_ptr[i];
+	for (k=0;k<n;k++)						//position in at.val of every entry of a
+		for (l=a.col_ptr[k];l<a.col_ptr[k+1];l++)
+			apos[l]=next[a.row_ind[l]]++;
+	cptr.assign(nz+1,0);
+	contrib.resize(2*(Int)total);
+	for (Int pass=0;pass<2;pass++) {
+		for (i=0;i<m;i++) {
+			for (s=adat->col_ptr[i];s<adat->col_ptr[i+1];s++)
+				slot[adat->row_ind[s]]=s;
+			for (j=at.col_ptr[i];j<at.col_ptr[i+1];j++) {
+				k=at.row_ind[j];
+				for (l=a.col_ptr[k];l<a.col_ptr[k+1];l++) {
+					s=slot[a.row_ind[l]];
+					if (pass == 0)
+						cptr[s+1]++;
+					else {
+						h=next[s]++;
+						contrib[2*h]=j;
+						contrib[2*h+1]=apos[l];
+					}
+				}
+			}
+		}
+		if (pass == 0) {
+			for (s=0;s<nz;s++)
+				cptr[s+1]+=cptr[s];
+			for (s=0;s<nz;s++)
+				next[s]=cptr[s];
+		}
+	}
+	ad.resize(at.col_ptr[m]);
+}
+void ADAT::updateD(const VecDoub &D)
+/*
+ adat = A.D.A^T from the contribution index: the entries A_ik D_k are formed once, then
+ every entry is a gather of its products, one column of adat per thread.
+*/
+{
+	if (cptr.size() == 0) {
+		updateD_scatter(D);
+		return;
+	}
+	Int m=a.nrows, nnz=at.col_ptr[m];
+	const Int *cp=&cptr[0], *ct=&contrib[0], *ck=&at.row_ind[0], *colp=&adat->col_ptr[0];
+	const Doub *atv=&at.val[0];
+	Doub *w=&ad[0], *v=&adat->val[0];
+#ifdef _OPENMP
+#pragma omp parallel if (cptr[cptr.size()-1] > 65536)
+#endif
+	{
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+		for (Int j=0;j<nnz;j++)
+			w[j]=atv[j]*D[ck[j]];
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic,16)
+#endif
+		for (Int i=0;i<m;i++)
+			for (Int s=colp[i];s<colp[i+1];s++) {
+				Doub t=0.0;
+				for (Int c=cp[s];c<cp[s+1];c++)
+					t += w[ct[2*c]]*atv[ct[2*c+1]];
+				v[s]=t;
+			}
+	}
 }
-void ADAT::updateD(const VecDoub &D) {
-	Int h,i,j,k,l,m=a.nrows,n=a.ncols;
-	VecDoub temp(n),temp2(m,0.0);
+void ADAT::updateD_scatter(const VecDoub &D) {
+	Int h,i,j,k,l,m=a.nrows;
 	for (i=0;i<m;i++) {
 		for (j=at.col_ptr[i];j< at.col_ptr[i+1];j++) {
 			k=at.row_ind[j];
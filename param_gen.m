@@ -9,11 +9,16 @@ clear all;
 N = 3;
 M = 3;
 K = 1;
+SIGNED = 0;            % 1 for a signed x, which only the basis pursuit build of
+                       % the simplex programs (-DBASIS_PURSUIT) can decode
 Phi = rand(M,N)        % Create a random Phi matrix holding values from 0-1
 x = zeros(N, 1);       % Initialize x vector
 v = randperm(N)        % Create random permutation of integers from 1 to N
                        % acting as indices of x
 x(v(1:K)) = rand(1,K)  % Create sparse x vector
+if SIGNED
+    x(v(1:K)) = 2*x(v(1:K))-1
+end
 y = Phi*x              % Create y vector
 TS = zeros(M+2,N+2);
 TS(3:M+2,3:N+2)=-Phi;  % Place -Phi matrix into TS
@@ -0,0 +1,281 @@
+/*
+Begin bpfront.h
+*/
+
+/*
+ Basis pursuit front end for the simplex engines. Given Phi (M x N, column major) and y
+ it solves
+
+	minimize sum(u) + sum(v)  subject to  Phi (u - v) = y,  u, v >= 0
+
+ and returns x = u - v, so signed sparse signals can be decoded; the tableaus written by
+ param_gen.m only describe x >= 0. The 2N columns [Phi, -Phi] are never formed:
+
+ - BPColumns hands the split problem to RSimplex (rsimplex.h). A column of the second
+   half is the negated column of Phi, and pricing computes Phi^T pi once for both halves.
+
+ - BPTableau is a dense tableau method in the spirit of simplexv2 that stores only
+   B^-1 Phi (M x N) and B^-1 y. The column of v_j is minus the column of u_j, and its
+   reduced cost is (c_u + c_v) - d_u_j, so both halves are priced from one row. Rows are
+   kept in the padded Tableau of tableau.h and updated with tab_axpy.
+
+ bp_revised_bounded() adds weights and a box: it minimizes sum w_j |x_j| subject to
+ Phi x = y, lo <= x <= hi, the bounds going to the bounded variable form of RSimplex so
+ that the LP keeps M rows.
+
+ bp_revised_batch() decodes a stream of measurement vectors for one Phi, each solve warm
+ started from the optimal basis of the previous one.
+
+ bp_load() takes Phi and y out of a generated simplexv2 or tsimplexv2 header, which both
+ hold y in column 1 and -Phi in rows 2..M+1, columns 2..N+1.
+
+ The solvers return the codes of simplx: 0 optimal, 1 unbounded, -1 infeasible and 2 if
+ the iteration limit was reached.
+*/
+
+#ifndef _BPFRONT_H_
+#define _BPFRONT_H_
+
+#include "tableau.h"
+#include "rsimplex.h"
+
+template <class A>
+void bp_load(const A &tab, int m, int n, double *Phi, double *y)
+// Phi[j*m+i] = Phi_ij and y[i] from a generated header tableau
+{
+	for (int i=0; i<m; i++) {
+		y[i] = tab[i+2][1];
+		for (int j=0; j<n; j++) Phi[(size_t)j*m+i] = -tab[i+2][j+2];
+	}
+}
+
+struct BPColumns : RSColumns {
+// The 2N columns [Phi, -Phi] of the split problem, Phi dense and column major
+	const double *Phi;
+	int nphi;
+	BPColumns(int mm, int nn, const double *PP) : RSColumns(mm, 2*nn), Phi(PP), nphi(nn) {}
+	void col(int j, double *a) const {
+		int i;
+		if (j < nphi) memcpy(a, Phi+(size_t)j*m, sizeof(double)*m);
+		else {
+			const double *p=Phi+(size_t)(j-nphi)*m;
+			for (i=0; i<m; i++) a[i] = -p[i];
+		}
+	}
+	void atx(const double *pi, double *d) const {
+		int i,j;
+		for (j=0; j<nphi; j++) {
+			const double *p=Phi+(size_t)j*m;
+			double s=0.0;
+			for (i=0; i<m; i++) s += p[i]*pi[i];
+			d[j] = s;
+			d[nphi+j] = -s;
+		}
+	}
+};
+
+int bp_revised(const double *Phi, int m, int n, const double *y, double *x, int *pivots=NULL)
+// Basis pursuit with the revised simplex engine
+{
+	int j,st;
+	BPColumns cols(m, n, Phi);
+	vector<double> c(2*n, 1.0), uv(2*n);
+	RSimplex lp(cols, y, &c[0]);
+	st = lp.solve(&uv[0]);
+	for (j=0; j<n; j++) x[j] = uv[j]-uv[n+j];
+	if (pivots) *pivots = lp.iters;
+	return st;
+}
+
+int bp_revised_bounded(const double *Phi, int m, int n, const double *y, const double *w,
+	const double *lo, const double *hi, double *x, int *pivots=NULL)
+/*
+ Weighted, box constrained basis pursuit with the revised simplex engine. w, lo and hi
+ may be NULL (unit weights, no bounds); lo may hold -HUGE_VAL and hi HUGE_VAL.
+*/
+{
+	int j,st;
+	double l,h;
+	BPColumns cols(m, n, Phi);
+	vector<double> c(2*n), uv(2*n), ul(2*n), uu(2*n);
+	for (j=0; j<n; j++) {
+		c[j] = c[n+j] = w ? w[j] : 1.0;
+		l = lo ? lo[j] : -HUGE_VAL;
+		h = hi ? hi[j] : HUGE_VAL;
+		// u_j carries the part of the box above zero, v_j the part below
+		ul[j] = l > 0.0 ? l : 0.0;
+		uu[j] = h > 0.0 ? h : 0.0;
+		ul[n+j] = h < 0.0 ? -h : 0.0;
+		uu[n+j] = l < 0.0 ? -l : 0.0;
+	}
+	RSimplex lp(cols, y, &c[0]);
+	lp.set_bounds(&ul[0], &uu[0]);
+	st = lp.solve(&uv[0]);
+	for (j=0; j<n; j++) x[j] = uv[j]-uv[n+j];
+	if (pivots) *pivots = lp.iters;
+	return st;
+}
+
+int bp_revised_batch(const double *Phi, int m, int n, int k, const double *Y, double *X,
+	int *pivots=NULL)
+/*
+ Basis pursuit for the k measurement vectors in the columns of Y (m x k), all with the
+ same Phi; X is n x k. Every solve is warm started from the optimal basis of the previous
+ one (RSimplex::resolve). Returns the number of vectors that were not solved.
+*/
+{
+	int j,l,nfail=0;
+	BPColumns cols(m, n, Phi);
+	vector<double> c(2*n, 1.0), uv(2*n);
+	RSimplex lp(cols, Y, &c[0]);
+	if (pivots) *pivots = 0;
+	for (l=0; l<k; l++) {
+		if (lp.resolve(Y+(size_t)l*m, &uv[0]) != 0) nfail++;
+		for (j=0; j<n; j++) X[(size_t)l*n+j] = uv[j]-uv[n+j];
+		if (pivots) *pivots += lp.iters;
+	}
+	return nfail;
+}
+
+struct BPTableau {
+	int m, n;
+	Tableau T;		// rows 0..m-1: B^-1 [Phi y], row m: reduced costs of u and -objective
+	vector<int> head;	// head[i]: u_j = j, v_j = n+j, artificial 2n+i
+	vector<int> posu, posv;	// row in which u_j / v_j is basic, -1 if nonbasic
+	int maxits;
+	double eps, pivtol;
+	int iters;
+
+	BPTableau(const double *Phi, int mm, int nn, const double *y);
+	int solve(double *x);
+	void pivot(int r, int q, int s, double dq);
+	int iterate(double C);
+};
+
+BPTableau::BPTableau(const double *Phi, int mm, int nn, const double *y) :
+	m(mm), n(nn), T(mm+1, nn+1), head(mm), posu(nn, -1), posv(nn, -1),
+	maxits(50*(mm+2*nn)), eps(1.0e-9), pivtol(1.0e-9), iters(0)
+{
+	// rows with negative y are negated so the artificial basis is feasible
+	for (int i=0; i<m; i++) {
+		double s = y[i] < 0.0 ? -1.0 : 1.0;
+		for (int j=0; j<n; j++) T[i][j] = s*Phi[(size_t)j*m+i];
+		T[i][n] = s*y[i];
+	}
+}
+
+void BPTableau::pivot(int r, int q, int s, double dq)
+/*
+ Bring u_q (s = 1) or v_q (s = -1) into the basis in row r; dq is its reduced cost.
+ The entering column is s*T[.][q], so every row except r is updated as for u_q, row r is
+ divided by the signed pivot and the cost row is updated with dq.
+*/
+{
+	int i,jb,nb;
+	double *prow=T[r];
+	double *f=T.f;
+	double rpiv=1.0/T[r][q];
+
+	for (i=0; i<m; i++)
+		f[i] = T[i][q]*rpiv;
+	f[r] = 0.0;
+	f[m] = s*dq*rpiv;
+	for (jb=0; jb<=n; jb+=TAB_BLOCK) {
+		nb = n+1-jb < TAB_BLOCK ? n+1-jb : TAB_BLOCK;
+		for (i=0; i<=m; i++)
+			if (f[i] != 0.0) tab_axpy(T[i]+jb, prow+jb, f[i], nb);
+	}
+	tab_scal(prow, s*rpiv, n+1);
+	if (head[r] < n) posu[head[r]] = -1;
+	else if (head[r] < 2*n) posv[head[r]-n] = -1;
+	head[r] = s > 0 ? q : n+q;
+	if (s > 0) posu[q] = r;
+	else posv[q] = r;
+	iters++;
+}
+
+int BPTableau::iterate(double C)
+/*
+ One pivot with the reduced costs in row m; C = c_u + c_v. Returns 0 if optimal,
+ 1 if unbounded, 2 after a pivot.
+*/
+{
+	int i,j,q=-1,s=1,r=-1;
+	double dmin=-eps,dj,alpha,ratio,best=0.0,abest=0.0;
+	const double *z=T[m];
+	for (j=0; j<n; j++) {
+		if (posu[j] >= 0 || posv[j] >= 0) continue;
+		if ((dj=z[j]) < dmin) {dmin=dj; q=j; s=1;}
+		if ((dj=C-z[j]) < dmin) {dmin=dj; q=j; s=-1;}
+	}
+	if (q < 0) return 0;
+	for (i=0; i<m; i++) {
+		alpha = s*T[i][q];
+		if (alpha > pivtol) {
+			ratio = (T[i][n] > 0.0 ? T[i][n] : 0.0)/alpha;
+			if (r < 0 || ratio < best-eps || (ratio <= best+eps && alpha > abest)) {
+				best=ratio;
+				abest=alpha;
+				r=i;
+			}
+		}
+	}
+	if (r < 0) return 1;
+	pivot(r, q, s, dmin);
+	return 2;
+}
+
+int BPTableau::solve(double *x)
+{
+	int i,j,q,st;
+	double *z=T[m],amax,ysum;
+	// phase one: all artificial basis, minimize the sum of the artificials
+	for (i=0; i<m; i++) head[i]=2*n+i;
+	for (j=0; j<=n; j++) {
+		z[j]=0.0;
+		for (i=0; i<m; i++) z[j] -= T[i][j];
+	}
+	ysum = -z[n];
+	while ((st=iterate(0.0)) == 2)
+		if (iters >= maxits) return 2;
+	if (-z[n] > eps*(1.0+ysum)) return -1;
+	// drive the remaining artificials out of the basis
+	for (i=0; i<m; i++) {
+		if (head[i] < 2*n) continue;
+		q=-1;
+		amax=pivtol;
+		for (j=0; j<n; j++)
+			if (posu[j] < 0 && posv[j] < 0 && fabs(T[i][j]) > amax) {
+				amax=fabs(T[i][j]);
+				q=j;
+			}
+		if (q >= 0) pivot(i, q, 1, 0.0);	// redundant row otherwise
+	}
+	// phase two: unit costs, z_j = 1 - c_B^T B^-1 Phi_j
+	for (j=0; j<=n; j++) {
+		z[j] = j < n ? 1.0 : 0.0;
+		for (i=0; i<m; i++)
+			if (head[i] < 2*n) z[j] -= T[i][j];
+	}
+	while ((st=iterate(2.0)) == 2)
+		if (iters >= maxits) return 2;
+	for (j=0; j<n; j++) x[j]=0.0;
+	for (i=0; i<m; i++) {
+		if (head[i] < n) x[head[i]] += T[i][n];
+		else if (head[i] < 2*n) x[head[i]-n] -= T[i][n];
+	}
+	return st;
+}
+
+int bp_tableau(const double *Phi, int m, int n, const double *y, double *x, int *pivots=NULL)
+// Basis pursuit with the dense tableau engine
+{
+	BPTableau lp(Phi, m, n, y);
+	int st = lp.solve(x);
+	if (pivots) *pivots = lp.iters;
+	return st;
+}
+
+#endif /* _BPFRONT_H_ */
+
+//end of file bpfront.h
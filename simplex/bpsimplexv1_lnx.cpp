@@ -0,0 +1,131 @@
+/*
+Begin bpsimplexv1.cpp
+*/
+
+/*
+ Driver for the basis pursuit front end in bpfront.h. A random problem is generated as
+ in param_gen.m, Phi is M x N with entries uniform in [0,1), except that the K nonzeros
+ of x are signed, y = Phi x, and x is decoded by both split variable engines, the dense
+ tableau (bp_tableau) and the revised simplex (bp_revised). The revised engine is also
+ run with the box -1 <= x <= 1 that holds for the generated signal (bp_revised_bounded).
+
+ Usage: bpsimplexv1 M N K [seed]
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/sysinfo.h>
+#include <sys/sysctl.h>
+#include <sys/times.h>
+#include <sys/vtimes.h>
+#include <sys/resource.h>
+#include "bpfront.h"
+using namespace std;
+
+void getSystemValues() {
+        FILE* file = fopen("/proc/self/status", "r");
+        char line[50];
+        while (fgets(line, 50, file) != NULL) {
+		if (strncmp(line, "VmData:", 7) == 0) printf("\n       Size of data segment - %s", line);
+		if (strncmp(line, "VmStk:", 6) == 0) printf("       Size of stack segment - %s", line);
+		if (strncmp(line, "VmExe:", 6) == 0) printf("       Size of text segment - %s", line);
+        }
+        fclose(file);
+}
+
+timespec diff(timespec start, timespec end)
+{
+	timespec temp;
+	if ((end.tv_nsec-start.tv_nsec)<0) {
+		temp.tv_sec = end.tv_sec-start.tv_sec-1;
+		temp.tv_nsec = 1000000000+end.tv_nsec-start.tv_nsec;
+	} else {
+		temp.tv_sec = end.tv_sec-start.tv_sec;
+		temp.tv_nsec = end.tv_nsec-start.tv_nsec;
+	}
+	return temp;
+}
+
+double snr(const vector<double> &xact, const vector<double> &xest) {
+	double MSE0=0.0, Ps=0.0;
+	for (size_t i=0; i<xact.size(); i++) {
+		MSE0 += pow(xact[i]-xest[i],2);
+		Ps += pow(xact[i],2);
+	}
+	return 10*log10(Ps/MSE0);
+}
+
+int main(int argc, char **argv) {
+
+	int i,j,m,n,kk,icase,pivots;
+	vector<double> A, y, xact, xest;
+	timespec init_time, final_time;
+
+	if (argc < 4) {
+		printf(" Usage: %s M N K [seed]\n", argv[0]);
+		return 1;
+	}
+	m = atoi(argv[1]);
+	n = atoi(argv[2]);
+	kk = atoi(argv[3]);
+	srand(argc > 4 ? atoi(argv[4]) : 1);
+	A.resize((size_t)m*n);
+	for (size_t s=0; s<A.size(); s++) A[s] = (double)rand()/RAND_MAX;
+	xact.assign(n, 0.0);
+	for (i=0; i<kk; ) {
+		j = rand()%n;
+		if (xact[j] == 0.0) {
+			xact[j] = 2.0*rand()/RAND_MAX-1.0;
+			if (fabs(xact[j]) < 1e-3) xact[j] = 1e-3;
+			i++;
+		}
+	}
+	y.assign(m, 0.0);
+	for (j=0; j<n; j++)
+		for (i=0; i<m; i++) y[i] += A[(size_t)j*m+i]*xact[j];
+
+	printf("\n       Program basis pursuit simplex version 1 %d-%d-%d results:\n", n,m,kk);
+	printf("       M: %2d\n       N: %2d\n       K: %2d\n\n", m,n,kk);
+
+	xest.assign(n, 0.0);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &init_time);
+	icase = bp_tableau(&A[0], m, n, &y[0], &xest[0], &pivots);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &final_time);
+	timespec t = diff(init_time,final_time);
+	if (icase != 0)
+		printf(" No solution (error code = %d).\n", icase);
+	printf("       Tableau: %6d pivots, %12ld nanoseconds, SNR %.4f dB\n",
+		pivots, t.tv_sec*1000000000L+t.tv_nsec, snr(xact,xest));
+
+	xest.assign(n, 0.0);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &init_time);
+	icase = bp_revised(&A[0], m, n, &y[0], &xest[0], &pivots);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &final_time);
+	t = diff(init_time,final_time);
+	if (icase != 0)
+		printf(" No solution (error code = %d).\n", icase);
+	printf("       Revised: %6d pivots, %12ld nanoseconds, SNR %.4f dB\n",
+		pivots, t.tv_sec*1000000000L+t.tv_nsec, snr(xact,xest));
+
+	vector<double> lo(n, -1.0), hi(n, 1.0);
+	xest.assign(n, 0.0);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &init_time);
+	icase = bp_revised_bounded(&A[0], m, n, &y[0], NULL, &lo[0], &hi[0], &xest[0], &pivots);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &final_time);
+	t = diff(init_time,final_time);
+	if (icase != 0)
+		printf(" No solution (error code = %d).\n", icase);
+	printf("       Box:     %6d pivots, %12ld nanoseconds, SNR %.4f dB\n",
+		pivots, t.tv_sec*1000000000L+t.tv_nsec, snr(xact,xest));
+
+	getSystemValues();
+	return 0;
+}
+
+// end of file bpsimplexv1.cpp
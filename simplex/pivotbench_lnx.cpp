@@ -0,0 +1,112 @@
+/*
+Begin pivotbench.cpp
+*/
+
+/*
+ Benchmark of the simplex pivot (rank-1 tableau update). For each tableau size the
+ element-wise update of the original Formula() is timed against tableau_pivot() on
+ identical random tableaus, and the largest difference between the two results is
+ reported as a check.
+
+ Usage: pivotbench [pivots per size]
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tableau.h"
+using namespace std;
+
+timespec diff(timespec start, timespec end)
+{
+	timespec temp;
+	if ((end.tv_nsec-start.tv_nsec)<0) {
+		temp.tv_sec = end.tv_sec-start.tv_sec-1;
+		temp.tv_nsec = 1000000000+end.tv_nsec-start.tv_nsec;
+	} else {
+		temp.tv_sec = end.tv_sec-start.tv_sec;
+		temp.tv_nsec = end.tv_nsec-start.tv_nsec;
+	}
+	return temp;
+}
+
+double seconds(timespec t) {
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+void Formula(Tableau &TS, int NC, int NV, int P1, int P2) {
+	// element-wise update as done by simplexv2 before tableau_pivot
+	int I,J;
+
+	for (I=1; I<=NC+1; I++) {
+		if (I == P1) goto e70;
+		for (J=1; J<=NV+1; J++) {
+			if (J == P2) goto e60;
+			TS[I][J] -= TS[P1][J] * TS[I][P2] / TS[P1][P2];
+			e60:;}
+		e70:;}
+	TS[P1][P2] = 1.0 / TS[P1][P2];
+	for (J=1; J<=NV+1; J++) {
+		if (J == P2) goto e100;
+		TS[P1][J] *= fabs(TS[P1][P2]);
+		e100:;}
+	for (I=1; I<=NC+1; I++) {
+		if (I == P1) goto e110;
+		TS[I][P2] *= TS[P1][P2];
+		e110:;}
+}
+
+int main(int argc, char **argv) {
+
+	const int SIZES[][2] = {{50,200},{100,400},{250,1000},{500,2000},{1000,4000}};
+	const int NSIZES = sizeof(SIZES)/sizeof(SIZES[0]);
+	int npiv = argc > 1 ? atoi(argv[1]) : 20;
+	int s,I,J,p,P1,P2,NC,NV;
+	double err,t_ref,t_new;
+	timespec time1, time2;
+
+	printf("\n       Program pivotbench results (%d pivots per size):\n\n", npiv);
+	printf("       %6s %6s %16s %16s %9s %12s\n", "M", "N", "Formula ns/piv", "kernel ns/piv", "speedup", "max |diff|");
+	srand(1);
+	for (s=0; s<NSIZES; s++) {
+		NC = SIZES[s][0];
+		NV = SIZES[s][1];
+		Tableau A(NC+2,NV+2), B(NC+2,NV+2);
+		for (I=1; I<=NC+1; I++)
+			for (J=1; J<=NV+1; J++)
+				A[I][J] = B[I][J] = 2.0*rand()/RAND_MAX-1.0;
+		t_ref = t_new = 0.0;
+		for (p=0; p<npiv; p++) {
+			// negative, well scaled pivot, as selected by Pivot()
+			P1 = 2+rand()%NC;
+			P2 = 2+rand()%NV;
+			A[P1][P2] = B[P1][P2] = -1.0-(double)rand()/RAND_MAX;
+			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time1);
+			Formula(A,NC,NV,P1,P2);
+			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time2);
+			t_ref += seconds(diff(time1,time2));
+			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time1);
+			tableau_pivot(B,P1,P2,1,NC+1,1,NV+1);
+			clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time2);
+			t_new += seconds(diff(time1,time2));
+			// keep the entries bounded so later pivots stay meaningful
+			for (I=1; I<=NC+1; I++)
+				for (J=1; J<=NV+1; J++)
+					if (fabs(A[I][J]) > 1e3) A[I][J] = B[I][J] = 1.0;
+		}
+		err = 0.0;
+		for (I=1; I<=NC+1; I++)
+			for (J=1; J<=NV+1; J++)
+				if (fabs(A[I][J]-B[I][J]) > err) err = fabs(A[I][J]-B[I][J]);
+		printf("       %6d %6d %16.0f %16.0f %9.2f %12.3e\n", NC, NV,
+			1e9*t_ref/npiv, 1e9*t_new/npiv, t_ref/t_new, err);
+	}
+	printf("\n");
+	return 0;
+}
+
+//end of file pivotbench.cpp
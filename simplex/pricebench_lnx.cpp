@@ -0,0 +1,132 @@
+/*
+Begin pricebench.cpp
+*/
+
+/*
+ Benchmark of the entering column rules of pricing.h on the linear program of simplexv2
+ (maximize the sum of x subject to Phi x <= y, x >= 0) for random compressive sensing
+ problems: Phi is M x N uniform in [0,1), x is K-sparse and y = Phi x. The tableau is
+ built as param_gen.m does and solved by the Pivot()/Formula() loop of simplexv2, once
+ with every rule; pivots, time and the optimal objective (as a check) are reported.
+
+ Usage: pricebench [problems per size]
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tableau.h"
+#include "pricing.h"
+using namespace std;
+
+timespec diff(timespec start, timespec end)
+{
+	timespec temp;
+	if ((end.tv_nsec-start.tv_nsec)<0) {
+		temp.tv_sec = end.tv_sec-start.tv_sec-1;
+		temp.tv_nsec = 1000000000+end.tv_nsec-start.tv_nsec;
+	} else {
+		temp.tv_sec = end.tv_sec-start.tv_sec;
+		temp.tv_nsec = end.tv_nsec-start.tv_nsec;
+	}
+	return temp;
+}
+
+double seconds(timespec t) {
+	return t.tv_sec + 1e-9*t.tv_nsec;
+}
+
+int Simplex(Tableau &T, int NC, int NV, int rule)
+// simplexv2 on T with the given pricing rule; returns the number of pivots, -1 on failure
+{
+	Pricing PR;
+	int I,J,P1,P2,npiv=0;
+	double RAP,V,XMAX=0.0;
+
+	PR.init(rule,T,2,NC+1,2,NV+1);
+	for (;;) {
+		P2 = PR.select(T[1],NULL,2,NV+1,0,0.0,&XMAX);
+		if (XMAX <= 0.0) return npiv;
+		RAP = 999999.0;
+		P1 = -1;
+		for (I=2; I<=NC+1; I++) {
+			if (T[I][P2] >= 0.0) continue;
+			V = fabs(T[I][1] / T[I][P2]);
+			if (V < RAP) {
+				RAP = V;
+				P1 = I;
+			}
+		}
+		if (P1 < 0) return -1;
+		V = T[0][P2]; T[0][P2] = T[P1][0]; T[P1][0] = V;
+		PR.update(T,P1,P2,2,NC+1,2,NV+1);
+		tableau_pivot(T,P1,P2,1,NC+1,1,NV+1);
+		npiv++;
+		for (J=2; J<=NC+1; J++)
+			if (T[J][1] < 0.0) return -1;
+	}
+}
+
+int main(int argc, char **argv) {
+
+	const int SIZES[][3] = {{20,60,3},{80,256,8},{100,1000,10},{200,2000,20},{250,5000,25}};
+	const int NSIZES = sizeof(SIZES)/sizeof(SIZES[0]);
+	const char *NAMES[] = {"Dantzig", "Devex", "steepest", "partial"};
+	int nprob = argc > 1 ? atoi(argv[1]) : 3;
+	int s,p,r,I,J,NC,NV,K,np;
+	double pivots[4], times[4], obj[4], err;
+	timespec time1, time2;
+
+	printf("\n       Program pricebench results (%d problems per size):\n\n", nprob);
+	printf("       %5s %5s %4s %-9s %10s %14s %12s\n", "M", "N", "K", "rule", "pivots", "ms/problem", "max |dobj|");
+	srand(1);
+	for (s=0; s<NSIZES; s++) {
+		NC = SIZES[s][0];
+		NV = SIZES[s][1];
+		K = SIZES[s][2];
+		for (r=0; r<4; r++) pivots[r] = times[r] = obj[r] = 0.0;
+		err = 0.0;
+		for (p=0; p<nprob; p++) {
+			Tableau A(NC+2,NV+2), B(NC+2,NV+2);
+			double *x = new double[NV]();
+			for (I=0; I<K; ) {
+				J = rand()%NV;
+				if (x[J] == 0.0) {x[J] = (double)rand()/RAND_MAX+1e-3; I++;}
+			}
+			for (J=2; J<=NV+1; J++) {
+				A[0][J] = J-1;
+				A[1][J] = 1.0;
+			}
+			for (I=2; I<=NC+1; I++) {
+				A[I][0] = NV+I-1;
+				for (J=2; J<=NV+1; J++) {
+					A[I][J] = -(double)rand()/RAND_MAX;
+					A[I][1] -= A[I][J]*x[J-2];
+				}
+			}
+			delete [] x;
+			for (r=0; r<4; r++) {
+				for (I=0; I<NC+2; I++) memcpy(B[I], A[I], sizeof(double)*(NV+2));
+				clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time1);
+				np = Simplex(B,NC,NV,r);
+				clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time2);
+				if (np < 0) printf(" No solution with rule %s.\n", NAMES[r]);
+				pivots[r] += np;
+				times[r] += seconds(diff(time1,time2));
+				obj[r] = B[1][1];
+				if (fabs(obj[r]-obj[0]) > err) err = fabs(obj[r]-obj[0]);
+			}
+		}
+		for (r=0; r<4; r++)
+			printf("       %5d %5d %4d %-9s %10.1f %14.3f %12.3e\n", NC, NV, K, NAMES[r],
+				pivots[r]/nprob, 1e3*times[r]/nprob, err);
+		printf("\n");
+	}
+	return 0;
+}
+
+//end of file pricebench.cpp
@@ -0,0 +1,141 @@
+/*
+Begin pricing.h
+*/
+
+/*
+ Choice of the entering column for the tableau simplex codes (Pivot() in simplexv2 and
+ simp1() in tsimplexv2). Both keep the nonbasic columns of the tableau, with the
+ objective coefficients in one row z, and let a column with z_j > 0 enter. Columns are
+ referred to by their tableau index j, so the weights follow the column slot: after an
+ exchange the leaving variable takes the slot of the entering one.
+
+	PRICE_DANTZIG	largest z_j (the original rule)
+	PRICE_DEVEX	largest z_j^2/w_j with approximate reference weights, updated from
+			the pivot row only (Forrest and Goldfarb)
+	PRICE_STEEPEST	largest z_j^2/g_j with g_j = 1 + |alpha_j|^2 the squared norm of the
+			edge direction; the weights are set up from the initial tableau and
+			carried across pivots by the Goldfarb-Reid recurrence
+	PRICE_PARTIAL	Dantzig rule restricted to one segment of the columns, moving on to
+			the next segment only when the current one has no candidate
+
+ update() must be called before the exchange of tableau_pivot() or simp3(), while the
+ pivot row and column are still those of the old tableau.
+*/
+
+#ifndef _PRICING_H_
+#define _PRICING_H_
+
+#include <math.h>
+#include <vector>
+using namespace std;
+
+#define PRICE_DANTZIG 0
+#define PRICE_DEVEX 1
+#define PRICE_STEEPEST 2
+#define PRICE_PARTIAL 3
+
+struct Pricing {
+	int rule;
+	int next;		// partial pricing: first candidate of the next segment
+	int psize;		// partial pricing: candidates per segment
+	vector<double> w;	// weights, indexed by tableau column
+	vector<double> s;	// steepest edge: alpha_j . alpha_q of the last pivot
+
+	Pricing() : rule(PRICE_DANTZIG), next(0), psize(0) {}
+
+	template <class A>
+	void init(int rr, const A &a, int r0, int r1, int c0, int c1)
+	// Rows r0..r1 of the tableau are the constraints, columns c0..c1 the nonbasic variables
+	{
+		int i,j;
+		rule = rr;
+		next = 0;
+		psize = (c1-c0+1)/8 > 32 ? (c1-c0+1)/8 : 32;
+		w.assign(c1+1, 1.0);
+		s.assign(c1+1, 0.0);
+		if (rule == PRICE_STEEPEST)	// the slack basis: exact edge norms
+			for (j=c0; j<=c1; j++)
+				for (i=r0; i<=r1; i++) w[j] += a[i][j]*a[i][j];
+	}
+
+	int select(const double *z, const int *list, int k0, int k1, int off, double tol, double *zsel)
+	/*
+	 Candidates are k = k0..k1 with tableau column j = (list ? list[k] : k)+off, scored
+	 on the row z. Returns the chosen column and its z in *zsel. When no z_j exceeds tol
+	 the column with the largest z_j is returned, as the Dantzig rule would, so that the
+	 callers' optimality tests keep working.
+	*/
+	{
+		int k,j,kk,jbest=-1,nk=k1-k0+1;
+		double best=0.0,score;
+		if (nk <= 0) return -1;
+		if (rule == PRICE_PARTIAL && nk > psize) {
+			int start = next < nk ? next : 0;
+			for (kk=0; kk<nk; kk++) {
+				k = k0+(start+kk)%nk;
+				j = (list ? list[k] : k)+off;
+				if (z[j] > tol && (jbest < 0 || z[j] > best)) {
+					best = z[j];
+					jbest = j;
+				}
+				if (jbest >= 0 && (kk+1)%psize == 0) {
+					next = (start+kk+1)%nk;
+					break;
+				}
+			}
+		}
+		else if (rule == PRICE_DEVEX || rule == PRICE_STEEPEST) {
+			for (k=k0; k<=k1; k++) {
+				j = (list ? list[k] : k)+off;
+				if (z[j] > tol && (score=z[j]*z[j]/w[j]) > best) {
+					best = score;
+					jbest = j;
+				}
+			}
+		}
+		if (jbest < 0)			// Dantzig rule, also the fallback
+			for (k=k0; k<=k1; k++) {
+				j = (list ? list[k] : k)+off;
+				if (jbest < 0 || z[j] > z[jbest]) jbest = j;
+			}
+		*zsel = z[jbest];
+		return jbest;
+	}
+
+	template <class A>
+	void update(const A &a, int p, int q, int r0, int r1, int c0, int c1)
+	// Weights after the exchange on a[p][q]; constraint rows r0..r1, columns c0..c1
+	{
+		int i,j;
+		double r,apq=a[p][q],wq=w[q],t;
+		if (rule == PRICE_DEVEX) {
+			for (j=c0; j<=c1; j++) {
+				if (j == q) continue;
+				r = a[p][j]/apq;
+				if ((t=r*r*wq) > w[j]) w[j] = t;
+			}
+			t = wq/(apq*apq);
+			w[q] = t > 1.0 ? t : 1.0;
+		}
+		else if (rule == PRICE_STEEPEST) {
+			for (j=c0; j<=c1; j++) s[j] = 0.0;
+			for (i=r0; i<=r1; i++) {
+				double aiq=a[i][q];
+				if (aiq == 0.0) continue;
+				for (j=c0; j<=c1; j++) s[j] += aiq*a[i][j];
+			}
+			for (j=c0; j<=c1; j++) {
+				if (j == q) continue;
+				r = a[p][j]/apq;
+				if (r == 0.0) continue;
+				t = w[j]-2.0*r*s[j]+r*r*wq;
+				w[j] = t > 1.0+r*r ? t : 1.0+r*r;
+			}
+			w[q] = wq/(apq*apq);
+		}
+	}
+};
+
+#endif /* _PRICING_H_ */
+
+//end of file pricing.h
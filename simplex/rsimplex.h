@@ -0,0 +1,573 @@
+/*
+Begin rsimplex.h
+*/
+
+/*
+ Revised simplex method for linear programs in standard form
+
+	minimize c.x  subject to  A x = b,  x >= 0
+
+ Unlike simplexv2 and the tableau routine simplx in tsimplexv2, which update the whole
+ (m+2)x(n+2) tableau at every pivot, only an LU factorization of the m x m basis matrix
+ B is kept. After a pivot the factorization is not recomputed; instead the entering
+ column alpha = B^-1 a_q and the pivot row r are appended to an eta file (product form
+ of the inverse), and B is refactorized from scratch every `refactor` pivots or when the
+ eta file becomes unstable. The constraint matrix itself is never copied: its columns are
+ reached through an RSColumns object, which returns a single column on demand (FTRAN)
+ and prices all columns against a dual vector (A^T pi), so the per pivot work is
+ O(m^2 + nnz(A)) and the memory O(m^2) on top of A.
+
+ Phase one starts from an all artificial basis (rows with negative b_i are negated) and
+ minimizes the sum of the artificials; artificials that are still basic at zero level
+ afterwards are pivoted out when possible, and never enter again. The entering column is
+ chosen by the largest reduced cost (Dantzig rule), the leaving row by the minimum ratio
+ test with ties broken towards the largest pivot.
+
+ solve() returns, like simplx, 0 if an optimal solution was found, 1 if the objective
+ is unbounded, -1 if no feasible solution exists, and 2 if maxits pivots were exceeded.
+
+ set_bounds() turns the problem into one with bounds l <= x <= u (l finite, u may be
+ HUGE_VAL) without adding rows: x is shifted by l, a nonbasic variable sits at either of
+ its bounds, the ratio test also stops when a basic variable reaches its upper bound, and
+ an entering variable that reaches its own upper bound first just moves to it (a bound
+ flip, no basis change).
+
+ resolve() solves again for a new right-hand side b with the same A and c. The last
+ optimal basis stays dual feasible when only b changes, so instead of going through phase
+ one again B^-1 b is recomputed and the dual simplex method removes the negative basic
+ variables, usually in a few pivots. solve_batch() runs a sequence of right-hand sides
+ this way, each one starting from the basis of the previous one.
+*/
+
+#ifndef _RSIMPLEX_H_
+#define _RSIMPLEX_H_
+
+#include <stdio.h>
+#include <math.h>
+#include <string.h>
+#include <vector>
+using namespace std;
+
+struct RSColumns {
+// Access to the columns of the m x n constraint matrix A
+	int m, n;
+	RSColumns(int mm, int nn) : m(mm), n(nn) {}
+	virtual void col(int j, double *a) const = 0;		// a[0..m-1] = column j of A
+	virtual void atx(const double *pi, double *d) const = 0;	// d[0..n-1] = A^T pi
+	virtual ~RSColumns() {}
+};
+
+struct DenseColumns : RSColumns {
+// Dense column-major m x n matrix, optionally followed by m slack (identity) columns
+	const double *A;
+	int lda, nslack;
+	DenseColumns(int mm, int nn, const double *AA, int llda, bool slack=false) :
+		RSColumns(mm, nn+(slack ? mm : 0)), A(AA), lda(llda), nslack(slack ? mm : 0) {}
+	void col(int j, double *a) const {
+		int ns=n-nslack;
+		if (j < ns) memcpy(a, A+(size_t)j*lda, sizeof(double)*m);
+		else {
+			memset(a, 0, sizeof(double)*m);
+			a[j-ns] = 1.0;
+		}
+	}
+	void atx(const double *pi, double *d) const {
+		int i,j,ns=n-nslack;
+		for (j=0; j<ns; j++) {
+			const double *aj=A+(size_t)j*lda;
+			double s=0.0;
+			for (i=0; i<m; i++) s += aj[i]*pi[i];
+			d[j] = s;
+		}
+		for (j=ns; j<n; j++) d[j] = pi[j-ns];
+	}
+};
+
+struct RSimplex {
+	const RSColumns &a;
+	int m, n;
+	vector<double> b0;		// right-hand side as given
+	vector<double> b, c;		// right-hand side (shifted by the lower bounds, sign adjusted) and costs
+	vector<double> lo, up;		// bounds of the structural variables
+	vector<char> atub;		// atub[j]: nonbasic j is at its upper bound
+	vector<double> rsign;		// +1 or -1, sign applied to each row of A and b
+	vector<int> head;		// head[i]: variable basic in row i (j >= n is artificial j-n)
+	vector<int> pos;		// pos[j]: row in which j is basic, -1 if nonbasic
+	vector<double> xb;		// values of the basic variables
+	vector<double> lu;		// LU factors of the basis, column major, PB = LU
+	vector<int> piv;		// row interchanges of the LU factorization
+	vector<double> eta;		// eta file: entering columns, m doubles each
+	vector<int> etarow;		// pivot row of each eta column
+	vector<double> pi, d, w, cb, ar;	// work vectors
+	int maxits;			// maximum number of pivots
+	int refactor;			// refactorization frequency
+	double eps;			// feasibility and optimality tolerance
+	double pivtol;			// smallest acceptable pivot
+	int iters, nrefactor;		// statistics of the last solve
+	bool verbose;
+	bool warm;			// the basis is optimal, resolve() may start from it
+
+	RSimplex(const RSColumns &aa, const double *bb, const double *cc);
+	void set_bounds(const double *l, const double *u);
+	void set_rhs(bool resign);
+	int solve(double *x);
+	int resolve(const double *bb, double *x);
+	int solve_batch(int k, const double *Y, double *X, int *status=NULL);
+	void factorize();
+	void ftran(double *v);
+	void btran(double *v);
+	void update(int r, int q, const double *alpha);
+	void column(int j, double *v);
+	void price(const double *cost, double *dj);
+	int chuzr(const double *alpha, double delta, double &theta, bool &toub);
+	int iterate(const double *cost);
+	int dual_iterate();
+	void recompute_xb();
+	double objective(const double *cost);
+	void primal(double *x);
+	inline double ub(int j) const {return j < n ? up[j] : HUGE_VAL;}
+};
+
+RSimplex::RSimplex(const RSColumns &aa, const double *bb, const double *cc) :
+	a(aa), m(aa.m), n(aa.n), b0(bb, bb+aa.m), b(aa.m), c(cc, cc+aa.n), lo(aa.n, 0.0),
+	up(aa.n, HUGE_VAL), atub(aa.n, 0), rsign(aa.m, 1.0),
+	head(aa.m), pos(aa.n+aa.m, -1), xb(aa.m), lu((size_t)aa.m*aa.m), piv(aa.m),
+	pi(aa.m), d(aa.n), w(aa.m), cb(aa.m), ar(aa.n), maxits(50*(aa.m+aa.n)), refactor(64),
+	eps(1.0e-9), pivtol(1.0e-9), iters(0), nrefactor(0), verbose(false), warm(false) {}
+
+void RSimplex::column(int j, double *v)
+// Column j of the sign adjusted constraint matrix, artificials included
+{
+	int i;
+	if (j < n) {
+		a.col(j, v);
+		for (i=0; i<m; i++) v[i] *= rsign[i];
+	}
+	else {
+		for (i=0; i<m; i++) v[i] = 0.0;
+		v[j-n] = 1.0;
+	}
+}
+
+void RSimplex::factorize()
+// Dense LU factorization with partial pivoting of the current basis; empties the eta file
+{
+	int i,j,k,p;
+	double t,amax;
+	double *B=&lu[0];
+	for (j=0; j<m; j++)
+		column(head[j], B+(size_t)j*m);
+	for (k=0; k<m; k++) {
+		double *bk=B+(size_t)k*m;
+		p=k;
+		amax=fabs(bk[k]);
+		for (i=k+1; i<m; i++)
+			if (fabs(bk[i]) > amax) {
+				amax=fabs(bk[i]);
+				p=i;
+			}
+		piv[k]=p;
+		if (amax == 0.0) {
+			printf(" Singular basis in RSimplex::factorize.\n");
+			continue;
+		}
+		if (p != k)
+			for (j=0; j<m; j++) {
+				t=B[(size_t)j*m+k]; B[(size_t)j*m+k]=B[(size_t)j*m+p]; B[(size_t)j*m+p]=t;
+			}
+		t=1.0/bk[k];
+		for (i=k+1; i<m; i++) bk[i] *= t;
+		for (j=k+1; j<m; j++) {
+			double *bj=B+(size_t)j*m;
+			double f=bj[k];
+			if (f != 0.0)
+				for (i=k+1; i<m; i++) bj[i] -= f*bk[i];
+		}
+	}
+	eta.clear();
+	etarow.clear();
+	nrefactor++;
+}
+
+void RSimplex::ftran(double *v)
+// v = B^-1 v
+{
+	int i,j,k;
+	double t;
+	const double *B=&lu[0];
+	for (k=0; k<m; k++)
+		if (piv[k] != k) {t=v[k]; v[k]=v[piv[k]]; v[piv[k]]=t;}
+	for (j=0; j<m; j++) {
+		t=v[j];
+		if (t != 0.0) {
+			const double *bj=B+(size_t)j*m;
+			for (i=j+1; i<m; i++) v[i] -= t*bj[i];
+		}
+	}
+	for (j=m-1; j>=0; j--) {
+		const double *bj=B+(size_t)j*m;
+		if (bj[j] == 0.0) continue;
+		t=(v[j] /= bj[j]);
+		if (t != 0.0)
+			for (i=0; i<j; i++) v[i] -= t*bj[i];
+	}
+	for (k=0; k<(int)etarow.size(); k++) {
+		const double *al=&eta[(size_t)k*m];
+		int r=etarow[k];
+		t=v[r]/al[r];
+		if (t != 0.0)
+			for (i=0; i<m; i++) v[i] -= al[i]*t;
+		v[r]=t;
+	}
+}
+
+void RSimplex::btran(double *v)
+// v = B^-T v
+{
+	int i,j,k;
+	double t;
+	const double *B=&lu[0];
+	for (k=(int)etarow.size()-1; k>=0; k--) {
+		const double *al=&eta[(size_t)k*m];
+		int r=etarow[k];
+		t=v[r];
+		for (i=0; i<m; i++)
+			if (i != r) t -= al[i]*v[i];
+		v[r]=t/al[r];
+	}
+	for (j=0; j<m; j++) {
+		const double *bj=B+(size_t)j*m;
+		t=v[j];
+		for (i=0; i<j; i++) t -= bj[i]*v[i];
+		v[j]= bj[j] != 0.0 ? t/bj[j] : 0.0;
+	}
+	for (j=m-1; j>=0; j--) {
+		const double *bj=B+(size_t)j*m;
+		t=v[j];
+		for (i=j+1; i<m; i++) t -= bj[i]*v[i];
+		v[j]=t;
+	}
+	for (k=m-1; k>=0; k--)
+		if (piv[k] != k) {t=v[k]; v[k]=v[piv[k]]; v[piv[k]]=t;}
+}
+
+void RSimplex::update(int r, int q, const double *alpha)
+// Basis change: q enters in row r, alpha = B^-1 a_q
+{
+	int i;
+	double amax=0.0;
+	for (i=0; i<m; i++)
+		if (fabs(alpha[i]) > amax) amax=fabs(alpha[i]);
+	pos[head[r]] = -1;
+	head[r] = q;
+	pos[q] = r;
+	// a pivot that is small relative to its column makes the eta file unstable
+	if ((int)etarow.size() >= refactor || fabs(alpha[r]) < 1.0e-7*amax) {
+		factorize();
+		recompute_xb();
+	}
+	else {
+		eta.insert(eta.end(), alpha, alpha+m);
+		etarow.push_back(r);
+	}
+}
+
+void RSimplex::set_bounds(const double *l, const double *u)
+// Bounds l <= x <= u of the structural variables; NULL keeps 0 and HUGE_VAL
+{
+	for (int j=0; j<n; j++) {
+		lo[j] = l ? l[j] : 0.0;
+		up[j] = u ? u[j]-lo[j] : HUGE_VAL;	// kept relative to the lower bound
+	}
+	warm=false;
+}
+
+void RSimplex::set_rhs(bool resign)
+// b = b0 - A l, with the row signs chosen afresh when resign is set
+{
+	int i,j;
+	for (i=0; i<m; i++) b[i]=b0[i];
+	for (j=0; j<n; j++) {
+		if (lo[j] == 0.0) continue;
+		a.col(j, &w[0]);
+		for (i=0; i<m; i++) b[i] -= lo[j]*w[i];
+	}
+	if (resign)
+		for (i=0; i<m; i++) rsign[i] = b[i] < 0.0 ? -1.0 : 1.0;
+	for (i=0; i<m; i++) b[i] *= rsign[i];
+}
+
+void RSimplex::recompute_xb()
+// x_B = B^-1 (b - sum of the columns at their upper bound)
+{
+	int i,j;
+	for (i=0; i<m; i++) xb[i]=b[i];
+	for (j=0; j<n; j++)
+		if (pos[j] < 0 && atub[j]) {
+			column(j, &w[0]);
+			for (i=0; i<m; i++) xb[i] -= up[j]*w[i];
+		}
+	ftran(&xb[0]);
+}
+
+void RSimplex::price(const double *cost, double *dj)
+// Reduced costs dj = cost - A^T B^-T c_B of all structural columns
+{
+	int i,j;
+	for (i=0; i<m; i++) pi[i] = cost[head[i]];
+	btran(&pi[0]);
+	for (i=0; i<m; i++) w[i] = pi[i]*rsign[i];
+	a.atx(&w[0], dj);
+	for (j=0; j<n; j++) dj[j] = cost[j]-dj[j];
+}
+
+int RSimplex::chuzr(const double *alpha, double delta, double &theta, bool &toub)
+/*
+ Ratio test for x_q moving by delta*t (delta = +1 or -1), x_B by -delta*t*alpha. Returns
+ the row that blocks first, with the step in theta and toub set if the basic variable
+ stops at its upper bound, or -1 if no basic variable blocks.
+*/
+{
+	int i,r=-1;
+	double ai,ratio,u,abest=0.0;
+	theta=HUGE_VAL;
+	for (i=0; i<m; i++) {
+		ai = delta*alpha[i];
+		if (ai > pivtol)
+			ratio = (xb[i] > 0.0 ? xb[i] : 0.0)/ai;
+		else if (ai < -pivtol && (u=ub(head[i])) < HUGE_VAL)
+			ratio = (u > xb[i] ? u-xb[i] : 0.0)/(-ai);
+		else continue;
+		if (r < 0 || ratio < theta-eps || (ratio <= theta+eps && fabs(ai) > abest)) {
+			theta=ratio;
+			abest=fabs(ai);
+			toub = ai < 0.0;
+			r=i;
+		}
+	}
+	return r;
+}
+
+int RSimplex::iterate(const double *cost)
+/*
+ One primal simplex pivot with the costs cost[0..n+m-1] (artificials last).
+ Returns 0 if the basis is optimal, 1 if the problem is unbounded, 2 after a pivot
+ or a bound flip.
+*/
+{
+	int i,j,q=-1,r,lv;
+	double dmin=-eps,dj,theta,delta,xq;
+	bool toub=false;
+	price(cost, &d[0]);
+	for (j=0; j<n; j++) {
+		if (pos[j] >= 0) continue;
+		dj = atub[j] ? -d[j] : d[j];	// a variable at its upper bound can only decrease
+		if (dj < dmin) {
+			dmin=dj;
+			q=j;
+		}
+	}
+	if (q < 0) return 0;
+	delta = atub[q] ? -1.0 : 1.0;
+	vector<double> &alpha=cb;
+	column(q, &alpha[0]);
+	ftran(&alpha[0]);
+	r=chuzr(&alpha[0], delta, theta, toub);
+	if (up[q] <= theta) {			// bound flip
+		if (up[q] == HUGE_VAL) return 1;
+		for (i=0; i<m; i++) xb[i] -= delta*up[q]*alpha[i];
+		atub[q] = !atub[q];
+		iters++;
+		return 2;
+	}
+	xq = (atub[q] ? up[q] : 0.0)+delta*theta;
+	for (i=0; i<m; i++) xb[i] -= delta*theta*alpha[i];
+	lv=head[r];
+	if (lv < n) atub[lv] = toub;
+	xb[r]=xq;
+	atub[q]=0;
+	update(r, q, &alpha[0]);
+	iters++;
+	return 2;
+}
+
+double RSimplex::objective(const double *cost)
+{
+	double s=0.0;
+	for (int i=0; i<m; i++) s += cost[head[i]]*xb[i];
+	for (int j=0; j<n; j++)
+		if (pos[j] < 0 && atub[j]) s += cost[j]*up[j];
+	return s;
+}
+
+void RSimplex::primal(double *x)
+// The structural variables of the current basic solution
+{
+	int i,j;
+	for (j=0; j<n; j++) x[j] = lo[j]+(pos[j] < 0 && atub[j] ? up[j] : 0.0);
+	for (i=0; i<m; i++)
+		if (head[i] < n) x[head[i]] += xb[i];
+}
+
+int RSimplex::dual_iterate()
+/*
+ One dual simplex pivot, with the reduced costs of the structural columns in d. The most
+ infeasible basic variable leaves: one below zero or above its upper bound, or an
+ artificial above zero, which is fixed at zero in phase two. Returns 0 if the basis is
+ primal feasible, -1 if the problem is infeasible, 2 after a pivot.
+*/
+{
+	int i,j,q=-1,r=-1;
+	double dir=0.0,viol=eps,ratio,best=0.0,t,u,bound=0.0,sj,tq=0.0;
+	for (i=0; i<m; i++) {
+		u = head[i] < n ? up[head[i]] : 0.0;
+		if (-xb[i] > viol) {viol=-xb[i]; r=i; dir=1.0; bound=0.0;}
+		if (xb[i]-u > viol) {viol=xb[i]-u; r=i; dir=-1.0; bound=u;}
+	}
+	if (r < 0) return 0;
+	// row r of B^-1 A
+	for (i=0; i<m; i++) w[i]=0.0;
+	w[r]=1.0;
+	btran(&w[0]);
+	for (i=0; i<m; i++) w[i] *= rsign[i];
+	a.atx(&w[0], &ar[0]);
+	// dual ratio test: keep the reduced costs of the nonbasic columns of the right sign
+	for (j=0; j<n; j++) {
+		if (pos[j] >= 0) continue;
+		sj = atub[j] ? -1.0 : 1.0;
+		t = -dir*sj*ar[j];
+		if (t > pivtol) {
+			ratio = (sj*d[j] > 0.0 ? sj*d[j] : 0.0)/t;
+			if (q < 0 || ratio < best-eps || (ratio <= best+eps && t > tq)) {
+				best=ratio;
+				tq=t;
+				q=j;
+			}
+		}
+	}
+	if (q < 0) return -1;
+	column(q, &cb[0]);
+	ftran(&cb[0]);
+	t=(xb[r]-bound)/cb[r];
+	for (i=0; i<m; i++) xb[i] -= t*cb[i];
+	xb[r]=(atub[q] ? up[q] : 0.0)+t;
+	if (head[r] < n) atub[head[r]] = dir < 0.0;
+	atub[q]=0;
+	t=d[q]/ar[q];
+	for (j=0; j<n; j++) d[j] -= t*ar[j];
+	update(r, q, &cb[0]);
+	for (j=0; j<n; j++)
+		if (pos[j] >= 0) d[j]=0.0;
+	iters++;
+	return 2;
+}
+
+int RSimplex::resolve(const double *bb, double *x)
+// Solve for the right-hand side bb, starting from the last optimal basis if there is one
+{
+	int i,j,st;
+	for (i=0; i<m; i++) b0[i]=bb[i];
+	if (!warm) return solve(x);
+	vector<double> cost(n+m, 0.0);
+	for (j=0; j<n; j++) cost[j]=c[j];
+	iters=nrefactor=0;
+	set_rhs(false);
+	recompute_xb();
+	price(&cost[0], &d[0]);
+	while ((st=dual_iterate()) == 2)
+		if (iters >= maxits) {
+			warm=false;
+			return 2;
+		}
+	if (st < 0) {
+		warm=false;
+		return -1;
+	}
+	// clean up reduced costs that drifted negative in the incremental update
+	while ((st=iterate(&cost[0])) == 2)
+		if (iters >= maxits) {
+			warm=false;
+			return 2;
+		}
+	warm = st == 0;
+	primal(x);
+	return st;
+}
+
+int RSimplex::solve_batch(int k, const double *Y, double *X, int *status)
+/*
+ Solve for the k right-hand sides in the columns of Y (m x k, column major); the
+ solutions are stored in the columns of X (n x k). Each solve starts from the basis of
+ the previous one. Returns the number of right-hand sides without an optimal solution.
+*/
+{
+	int l,st,nfail=0;
+	for (l=0; l<k; l++) {
+		st=resolve(Y+(size_t)l*m, X+(size_t)l*n);
+		if (status) status[l]=st;
+		if (st != 0) nfail++;
+	}
+	return nfail;
+}
+
+int RSimplex::solve(double *x)
+{
+	int i,j,k,st;
+	vector<double> cost(n+m, 0.0);
+	iters=nrefactor=0;
+	warm=false;
+	set_rhs(true);
+	// phase one: all artificial basis, structurals at their lower bounds,
+	// minimize the sum of the artificials
+	for (j=0; j<n+m; j++) pos[j]=-1;
+	for (j=0; j<n; j++) atub[j]=0;
+	for (i=0; i<m; i++) {
+		head[i]=n+i;
+		pos[n+i]=i;
+	}
+	factorize();
+	recompute_xb();
+	for (i=0; i<m; i++) cost[n+i]=1.0;
+	double bnorm=0.0;
+	for (i=0; i<m; i++) bnorm += b[i];
+	while ((st=iterate(&cost[0])) == 2)
+		if (iters >= maxits) return 2;
+	if (objective(&cost[0]) > eps*(1.0+bnorm)) return -1;
+	// drive the remaining artificials out of the basis
+	for (i=0; i<m; i++) {
+		if (head[i] < n) continue;
+		for (k=0; k<m; k++) w[k]=0.0;
+		w[i]=1.0;
+		btran(&w[0]);
+		for (k=0; k<m; k++) w[k] *= rsign[k];
+		a.atx(&w[0], &d[0]);
+		int q=-1;
+		double amax=pivtol;
+		for (j=0; j<n; j++)
+			if (pos[j] < 0 && fabs(d[j]) > amax) {
+				amax=fabs(d[j]);
+				q=j;
+			}
+		if (q < 0) continue;		// redundant row, the artificial stays at zero
+		column(q, &cb[0]);
+		ftran(&cb[0]);
+		xb[i]=atub[q] ? up[q] : 0.0;	// x_q keeps its value
+		atub[q]=0;
+		update(i, q, &cb[0]);
+	}
+	// phase two
+	for (j=0; j<n; j++) cost[j]=c[j];
+	for (i=0; i<m; i++) cost[n+i]=0.0;
+	while ((st=iterate(&cost[0])) == 2)
+		if (iters >= maxits) return 2;
+	primal(x);
+	if (verbose)
+		printf("       RSimplex: %d pivots, %d factorizations, objective %.10g\n",
+			iters, nrefactor, objective(&cost[0]));
+	warm = st == 0;
+	return st;
+}
+
+#endif /* _RSIMPLEX_H_ */
+
+//end of file rsimplex.h
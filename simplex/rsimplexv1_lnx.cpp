@@ -0,0 +1,152 @@
+/*
+Begin rsimplexv1.cpp
+*/
+
+/*
+ Driver for the revised simplex engine in rsimplex.h.
+
+ Without arguments it solves the problem of the tsimplexv2 header, i.e. the same linear
+ program as simplx (maximize the sum of x subject to Phi x <= y, x >= 0, with the slack
+ columns supplied implicitly), so the results can be compared line by line.
+
+ With the arguments M N K a random problem is generated instead: Phi is M x N with
+ entries uniform in [0,1), x is K-sparse and nonnegative as in param_gen.m, y = Phi x,
+ and x is decoded by the nonnegative basis pursuit LP
+
+	minimize sum(x)  subject to  Phi x = y,  x >= 0
+
+ which is meant for the large N (tens of thousands) the tableau codes cannot handle.
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/sysinfo.h>
+#include <sys/sysctl.h>
+#include <sys/times.h>
+#include <sys/vtimes.h>
+#include <sys/resource.h>
+#include "rsimplex.h"
+#include "tsimplexv2-N3-M3-K1.h"
+//#include "tsimplexv2-N10-M6-K1.h"
+//#include "tsimplexv2-N20-M11-K2.h"
+//#include "tsimplexv2-N30-M11-K2.h"
+//#include "tsimplexv2-N40-M11-K3.h"
+//#include "tsimplexv2-N80-M16-K3.h"
+//#include "tsimplexv2-N256-M80-K8.h"
+using namespace std;
+
+void getSystemValues() {
+        FILE* file = fopen("/proc/self/status", "r");
+        char line[50];
+        while (fgets(line, 50, file) != NULL) {
+		if (strncmp(line, "VmData:", 7) == 0) printf("\n       Size of data segment - %s", line);
+		if (strncmp(line, "VmStk:", 6) == 0) printf("       Size of stack segment - %s", line);
+		if (strncmp(line, "VmExe:", 6) == 0) printf("       Size of text segment - %s", line);
+        }
+        fclose(file);
+}
+
+timespec diff(timespec start, timespec end)
+{
+	timespec temp;
+	if ((end.tv_nsec-start.tv_nsec)<0) {
+		temp.tv_sec = end.tv_sec-start.tv_sec-1;
+		temp.tv_nsec = 1000000000+end.tv_nsec-start.tv_nsec;
+	} else {
+		temp.tv_sec = end.tv_sec-start.tv_sec;
+		temp.tv_nsec = end.tv_nsec-start.tv_nsec;
+	}
+	return temp;
+}
+
+int main(int argc, char **argv) {
+
+	int i,j,m,n,kk,icase;
+	double MSE0, Ps, SNR;
+	vector<double> A, y, c, xact, xest;
+	bool synthetic = argc > 3;
+
+	if (synthetic) {
+		m = atoi(argv[1]);
+		n = atoi(argv[2]);
+		kk = atoi(argv[3]);
+		srand(argc > 4 ? atoi(argv[4]) : 1);
+		A.resize((size_t)m*n);
+		for (size_t s=0; s<A.size(); s++) A[s] = (double)rand()/RAND_MAX;
+		xact.assign(n, 0.0);
+		for (i=0; i<kk; ) {
+			j = rand()%n;
+			if (xact[j] == 0.0) {
+				xact[j] = (double)rand()/RAND_MAX+1e-3;
+				i++;
+			}
+		}
+		y.assign(m, 0.0);
+		for (j=0; j<n; j++)
+			for (i=0; i<m; i++) y[i] += A[(size_t)j*m+i]*xact[j];
+		c.assign(n, 1.0);
+	}
+	else {
+		// undo the tableau layout of param_gen.m: Phi[i+1][1] = y_i, Phi[i+1][j+1] = -Phi_ij
+		m = M;
+		n = N;
+		kk = k;
+		A.resize((size_t)m*n);
+		y.resize(m);
+		for (i=1; i<=m; i++) {
+			y[i-1] = Phi[i+1][1];
+			for (j=1; j<=n; j++) A[(size_t)(j-1)*m+i-1] = -Phi[i+1][j+1];
+		}
+		xact.assign(X_act, X_act+n);
+		c.assign(n+m, 0.0);
+		for (j=0; j<n; j++) c[j] = -1.0;	// simplx maximizes
+	}
+
+	printf("\n       Program revised simplex version 1 %d-%d-%d results:\n", n,m,kk);
+
+	DenseColumns cols(m, n, &A[0], m, !synthetic);
+	xest.assign(cols.n, 0.0);
+	timespec init_time, final_time;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &init_time);
+
+	RSimplex lp(cols, &y[0], &c[0]);
+	icase = lp.solve(&xest[0]);
+	if (icase != 0)
+		printf(" No solution (error code = %d).\n", icase);
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &final_time);
+	timespec t = diff(init_time,final_time);
+	printf("       M: %2d\n       N: %2d\n       K: %2d\n\n", m,n,kk);
+	printf("       Pivots: %d, factorizations: %d\n", lp.iters, lp.nrefactor);
+	printf("       Execution time: %ld nanoseconds\n\n", t.tv_sec*1000000000L+t.tv_nsec);
+
+	/* ********************************************************
+	   Computing the Signal-to-Noise Ratio, SNR = 10*log(Ps/MSE)
+	********************************************************* */
+
+	if (n <= 64)
+		for (i=0; i<n; i++)
+			printf("       [%d] Actual X:[%.16f] Approx X:[%.16f]\n", i, xact[i], xest[i]);
+
+	MSE0 = 0;
+	Ps = 0;
+	for (i=0; i<n; i++) {
+		MSE0 += pow(xact[i]-xest[i],2);
+		Ps += pow(xact[i],2);
+	}
+	printf("\n       Mean Square Error, MSE:              %.16f\n", MSE0/n);
+	printf("       Signal Power, Ps:                    %.16f\n", Ps/n);
+	SNR = 10*log10(Ps/MSE0);
+	printf("       Signal-to-Noise Ratio, SNR:          %.16f dB\n", SNR);
+
+	getSystemValues();
+	return 0;
+}
+
+// end of file rsimplexv1.cpp
@@ -15,6 +15,11 @@ Begin simplexv2.cpp
 #include <sys/times.h>
 #include <sys/vtimes.h>
 #include <sys/resource.h>
+#include "tableau.h"
+#include "pricing.h"
+#ifdef BASIS_PURSUIT
+#include "bpfront.h"
+#endif
 #include "simplexv2-N3-M3-K1.h"
 //#include "simplexv2-N10-M6-K1.h"
 //#include "simplexv2-N20-M11-K2.h"
@@ -24,7 +29,13 @@ Begin simplexv2.cpp
 //#include "simplexv2-N256-M80-K8.h"
 using namespace std;
 
+#ifndef PRICING
+#define PRICING PRICE_DANTZIG	// entering column rule, see pricing.h
+#endif
+
 int NOPTIMAL,P1,P2,XERR;
+Tableau T;	// working copy of TS, padded and aligned for the pivot kernel
+Pricing PR;
 
 void Data() {
 	//printf("\n RESULTS:\n");
@@ -35,65 +46,48 @@ void Formula();
 void Optimize();
 
 void Simplex() {
+	T.load(TS,NC+2,NV+2);
+	PR.init(PRICING,T,2,NC+1,2,NV+1);
 e10: Pivot();
 	Formula();
 	Optimize();
 	if (NOPTIMAL == 1) goto e10;
+	T.store(TS);
 }
 
 void Pivot() {
 	
 	double RAP,V,XMAX;
-	int I,J;
+	int I;
 	
-	XMAX = 0.0;
-	for(J=2; J<=NV+1; J++) {
-		if (TS[1][J] > 0.0 && TS[1][J] > XMAX) {
-			XMAX = TS[1][J];
-			P2 = J;
-		}
-	}
+	P2 = PR.select(T[1],NULL,2,NV+1,0,0.0,&XMAX);
 	RAP = 999999.0;
 	for (I=2; I<=NC+1; I++) {
-		if (TS[I][P2] >= 0.0) goto e10;
-		V = fabs(TS[I][1] / TS[I][P2]);
+		if (T[I][P2] >= 0.0) goto e10;
+		V = fabs(T[I][1] / T[I][P2]);
 		if (V < RAP) {
 			RAP = V;
 			P1 = I;
 		}
 		e10:;}
-	V = TS[0][P2]; TS[0][P2] = TS[P1][0]; TS[P1][0] = V;
+	V = T[0][P2]; T[0][P2] = T[P1][0]; T[P1][0] = V;
+	PR.update(T,P1,P2,2,NC+1,2,NV+1);
 }
 
-void Formula() {;
-	int I,J;
-	
-	for (I=1; I<=NC+1; I++) {
-		if (I == P1) goto e70;
-		for (J=1; J<=NV+1; J++) {
-			if (J == P2) goto e60;
-			TS[I][J] -= TS[P1][J] * TS[I][P2] / TS[P1][P2];
-			e60:;}
-		e70:;}
-	TS[P1][P2] = 1.0 / TS[P1][P2];
-	for (J=1; J<=NV+1; J++) {
-		if (J == P2) goto e100;
-		TS[P1][J] *= fabs(TS[P1][P2]);
-		e100:;}
-	for (I=1; I<=NC+1; I++) {
-		if (I == P1) goto e110;
-		TS[I][P2] *= TS[P1][P2];
-		e110:;}
-}   
+void Formula() {
+	// Pivots chosen by Pivot() are always negative, so scaling the pivot row by
+	// 1/|TS[P1][P2]| is the same as the -1/TS[P1][P2] applied by the kernel.
+	tableau_pivot(T,P1,P2,1,NC+1,1,NV+1);
+}
 
 void Optimize() {
 	int I,J;
 	for (I=2; I<=NC+1; I++)
-		if (TS[I][1] < 0.0)  XERR = 1;
+		if (T[I][1] < 0.0)  XERR = 1;
 	NOPTIMAL = 0;
 	if (XERR == 1)  return;
 	for (J=2; J<=NV+1; J++)
-		if (TS[1][J] > 0.0)  NOPTIMAL = 1;
+		if (T[1][J] > 0.0)  NOPTIMAL = 1;
 }
 
 void Results() {
@@ -144,16 +138,25 @@ timespec diff(timespec start, timespec end)
 int main()  {
 
 	printf("\n       Program simplex version 1 %d-%d-%d results:\n", NV,NC,k);
-	int I,J;
+	int I;
 	double MSE, Ps, SNR;
 	double X_est[NV];
 	
 	timespec time1, time2;
 	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time1);
 
+#ifdef BASIS_PURSUIT
+	// decode x = u - v from Phi and y with the split variable LP
+	double Phi_bp[NC*NV], y_bp[NC];
+	bp_load(TS,NC,NV,Phi_bp,y_bp);
+	if (bp_tableau(Phi_bp,NC,NV,y_bp,X_est) != 0)
+		printf(" NO SOLUTION.\n");
+	printf("\n");
+#else
 	Data();
 	Simplex();
 	Results();
+#endif
 	
 	printf("       M: %2d\n       N: %2d\n       K: %2d\n\n", NC,NV,k);
 	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time2);
@@ -165,6 +168,8 @@ int main()  {
 	********************************************************* */
 	//First compute the Mean Square Error, MSE
 	
+#ifndef BASIS_PURSUIT
+	int J;
 	for (I=1; I<=NV; I++) {
 		X_est[I-1] = 0.0;
 	}
@@ -177,6 +182,7 @@ int main()  {
 		e70: ;
 		}
 	}
+#endif
 	
 	for (I=0; I<NV; I++) {
 		printf("       [%d] Actual X:[%.16f] Approx X:[%.16f]\n", I, X_act[I],X_est[I]);
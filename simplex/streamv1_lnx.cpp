@@ -0,0 +1,168 @@
+/*
+Begin streamv1.cpp
+*/
+
+/*
+ Throughput of basis pursuit over a stream of related measurement vectors y_t = Phi x_t
+ with one Phi. x_0 is K-sparse and signed; from one vector to the next the amplitudes are
+ perturbed by a few percent and now and then one nonzero moves to another position.
+ The first vectors are decoded from scratch with bp_revised (phase one every time) and
+ the whole stream with bp_revised_batch, which warm starts each solve from the previous
+ optimal basis with the dual simplex method.
+
+ Usage: streamv1 [M N K [count [cold count [seed]]]]   (default 80 256 8 10000 200 1)
+*/
+
+#include <stdio.h>
+#include <math.h>
+#include <iostream>
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/sysinfo.h>
+#include <sys/sysctl.h>
+#include <sys/times.h>
+#include <sys/vtimes.h>
+#include <sys/resource.h>
+#include "bpfront.h"
+using namespace std;
+
+void getSystemValues() {
+        FILE* file = fopen("/proc/self/status", "r");
+        char line[50];
+        while (fgets(line, 50, file) != NULL) {
+		if (strncmp(line, "VmData:", 7) == 0) printf("\n       Size of data segment - %s", line);
+		if (strncmp(line, "VmStk:", 6) == 0) printf("       Size of stack segment - %s", line);
+		if (strncmp(line, "VmExe:", 6) == 0) printf("       Size of text segment - %s", line);
+        }
+        fclose(file);
+}
+
+timespec diff(timespec start, timespec end)
+{
+	timespec temp;
+	if ((end.tv_nsec-start.tv_nsec)<0) {
+		temp.tv_sec = end.tv_sec-start.tv_sec-1;
+		temp.tv_nsec = 1000000000+end.tv_nsec-start.tv_nsec;
+	} else {
+		temp.tv_sec = end.tv_sec-start.tv_sec;
+		temp.tv_nsec = end.tv_nsec-start.tv_nsec;
+	}
+	return temp;
+}
+
+double snr(const vector<double> &xact, const vector<double> &xest) {
+	double MSE0=0.0, Ps=0.0;
+	for (size_t i=0; i<xact.size(); i++) {
+		MSE0 += pow(xact[i]-xest[i],2);
+		Ps += pow(xact[i],2);
+	}
+	return 10*log10(Ps/MSE0);
+}
+
+int main(int argc, char **argv) {
+
+	int i,j,l,m=80,n=256,kk=8,count=10000,ncold=200,pivots,nfail;
+	double snrmin,snrsum,s,t_cold,t_warm;
+	vector<double> A, Y, X, xact, xest, supp;
+	vector<int> idx;
+	timespec init_time, final_time;
+
+	if (argc > 3) {
+		m = atoi(argv[1]);
+		n = atoi(argv[2]);
+		kk = atoi(argv[3]);
+	}
+	if (argc > 4) count = atoi(argv[4]);
+	if (argc > 5) ncold = atoi(argv[5]);
+	srand(argc > 6 ? atoi(argv[6]) : 1);
+	if (ncold > count) ncold = count;
+
+	A.resize((size_t)m*n);
+	for (size_t p=0; p<A.size(); p++) A[p] = (double)rand()/RAND_MAX;
+	// the stream of signals, one column of xact per vector
+	xact.assign((size_t)n*count, 0.0);
+	for (i=0; i<kk; ) {
+		j = rand()%n;
+		if (xact[j] == 0.0) {
+			xact[j] = 2.0*rand()/RAND_MAX-1.0;
+			if (fabs(xact[j]) < 1e-3) xact[j] = 1e-3;
+			idx.push_back(j);
+			i++;
+		}
+	}
+	for (l=1; l<count; l++) {
+		double *xp=&xact[(size_t)(l-1)*n], *xl=&xact[(size_t)l*n];
+		for (i=0; i<kk; i++)
+			xl[idx[i]] = xp[idx[i]]*(1.0+0.05*(2.0*rand()/RAND_MAX-1.0));
+		if (rand()%20 == 0) {
+			i = rand()%kk;
+			j = rand()%n;
+			if (xl[j] == 0.0) {
+				xl[j] = xl[idx[i]];
+				xl[idx[i]] = 0.0;
+				idx[i] = j;
+			}
+		}
+	}
+	Y.assign((size_t)m*count, 0.0);
+	for (l=0; l<count; l++)
+		for (j=0; j<n; j++) {
+			s = xact[(size_t)l*n+j];
+			if (s != 0.0)
+				for (i=0; i<m; i++) Y[(size_t)l*m+i] += A[(size_t)j*m+i]*s;
+		}
+
+	printf("\n       Program stream simplex version 1 %d-%d-%d results:\n", n,m,kk);
+	printf("       M: %2d\n       N: %2d\n       K: %2d\n       Vectors: %d\n\n", m,n,kk,count);
+
+	// cold starts on the first ncold vectors
+	xest.assign(n, 0.0);
+	pivots = nfail = 0;
+	snrmin = 1e300;
+	snrsum = 0.0;
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &init_time);
+	for (l=0; l<ncold; l++) {
+		int p;
+		if (bp_revised(&A[0], m, n, &Y[(size_t)l*m], &xest[0], &p) != 0) nfail++;
+		pivots += p;
+		vector<double> xa(&xact[(size_t)l*n], &xact[(size_t)(l+1)*n]);
+		s = snr(xa, xest);
+		snrsum += s;
+		if (s < snrmin) snrmin = s;
+	}
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &final_time);
+	timespec t = diff(init_time,final_time);
+	t_cold = (t.tv_sec+1e-9*t.tv_nsec)/ncold;
+	printf("       Cold start: %6d vectors, %8.1f pivots/vector, %10.0f vectors/s, failures %d\n",
+		ncold, (double)pivots/ncold, 1.0/t_cold, nfail);
+	printf("                   SNR mean %.2f dB, min %.2f dB\n", snrsum/ncold, snrmin);
+
+	// the whole stream, warm started
+	X.assign((size_t)n*count, 0.0);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &init_time);
+	nfail = bp_revised_batch(&A[0], m, n, count, &Y[0], &X[0], &pivots);
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &final_time);
+	t = diff(init_time,final_time);
+	t_warm = (t.tv_sec+1e-9*t.tv_nsec)/count;
+	snrmin = 1e300;
+	snrsum = 0.0;
+	for (l=0; l<count; l++) {
+		vector<double> xa(&xact[(size_t)l*n], &xact[(size_t)(l+1)*n]);
+		vector<double> xe(&X[(size_t)l*n], &X[(size_t)(l+1)*n]);
+		s = snr(xa, xe);
+		snrsum += s;
+		if (s < snrmin) snrmin = s;
+	}
+	printf("       Warm start: %6d vectors, %8.1f pivots/vector, %10.0f vectors/s, failures %d\n",
+		count, (double)pivots/count, 1.0/t_warm, nfail);
+	printf("                   SNR mean %.2f dB, min %.2f dB\n", snrsum/count, snrmin);
+	printf("       Speedup per vector: %.2f\n", t_cold/t_warm);
+
+	getSystemValues();
+	return 0;
+}
+
+// end of file streamv1.cpp
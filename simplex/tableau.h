@@ -0,0 +1,149 @@
+/*
+Begin tableau.h
+*/
+
+/*
+ Dense simplex tableau kept in one contiguous block. Every row starts on a 64 byte
+ boundary and is padded to a multiple of TAB_PAD doubles, so a row of the tableau
+ can be streamed with aligned SIMD loads. Rows are reached through t[i], which gives
+ the usual t[i][j] subscripting of the fixed size arrays in the generated headers.
+
+ tableau_pivot() performs the exchange of a left-hand (basic) and a right-hand
+ (nonbasic) variable, i.e. the rank-1 update done by Formula() in simplexv2 and by
+ simp3() in tsimplexv2:
+
+	rows i != p:  a[i][j] -= a[p][j]*a[i][q]/a[p][q]   (j != q)
+	              a[i][q]  = a[i][q]/a[p][q]
+	row p:        a[p][j]  = -a[p][j]/a[p][q]          (j != q)
+	              a[p][q]  = 1/a[p][q]
+
+ The reciprocal of the pivot is formed once and the multipliers of the pivot column
+ are saved before the update, so the inner loop is a branch free axpy over the whole
+ row; the pivot column and the pivot row are fixed up afterwards. Columns are swept in
+ panels of TAB_BLOCK so that the slice of the pivot row stays in L1 while every row of
+ the tableau streams past it.
+*/
+
+#ifndef _TABLEAU_H_
+#define _TABLEAU_H_
+
+#include <stdlib.h>
+#include <string.h>
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#define TAB_ALIGN 64		// byte alignment of every row
+#define TAB_PAD 8		// row length is rounded up to a multiple of TAB_PAD doubles
+#define TAB_BLOCK 512		// number of columns per panel in tableau_pivot
+
+struct Tableau {
+	int nrows;		// number of rows
+	int ncols;		// number of columns actually used
+	int ld;			// leading dimension (padded row length)
+	double *v;		// nrows*ld doubles, row major
+	double *f;		// scratch for the multipliers of the pivot column
+
+	Tableau() : nrows(0), ncols(0), ld(0), v(NULL), f(NULL) {}
+	Tableau(int m, int n) : nrows(0), ncols(0), ld(0), v(NULL), f(NULL) {resize(m,n);}
+
+	void resize(int m, int n) {		// contents are set to zero
+		release();
+		nrows = m;
+		ncols = n;
+		ld = (n+TAB_PAD-1)/TAB_PAD*TAB_PAD;
+		if (posix_memalign((void **)&v, TAB_ALIGN, sizeof(double)*(size_t)m*ld+1) != 0) v = NULL;
+		if (posix_memalign((void **)&f, TAB_ALIGN, sizeof(double)*(size_t)m+1) != 0) f = NULL;
+		if (v) memset(v, 0, sizeof(double)*(size_t)m*ld);
+	}
+
+	inline double *operator[](int i) {return v+(size_t)i*ld;}
+	inline const double *operator[](int i) const {return v+(size_t)i*ld;}
+
+	template <class A>
+	void load(A &a, int m, int n) {		// copy a fixed size array a[m][n]
+		resize(m,n);
+		for (int i=0; i<m; i++)
+			for (int j=0; j<n; j++) (*this)[i][j] = a[i][j];
+	}
+
+	template <class A>
+	void store(A &a) const {		// copy back into a fixed size array
+		for (int i=0; i<nrows; i++)
+			for (int j=0; j<ncols; j++) a[i][j] = (*this)[i][j];
+	}
+
+	void release() {
+		free(v);
+		free(f);
+		v = f = NULL;
+	}
+
+	~Tableau() {release();}
+
+private:
+	Tableau(const Tableau &);
+	Tableau &operator=(const Tableau &);
+};
+
+// y[0..n-1] -= a*x[0..n-1]
+static inline void tab_axpy(double *y, const double *x, double a, int n) {
+	int j=0;
+#if defined(__AVX__)
+	// peel until y is 32 byte aligned; the rows share one alignment, so x is too
+	for (; j<n && (((size_t)(y+j)) & 31); j++) y[j] -= a*x[j];
+	__m256d va = _mm256_set1_pd(a);
+	for (; j+8<=n; j+=8) {
+#if defined(__FMA__)
+		_mm256_store_pd(y+j, _mm256_fnmadd_pd(va, _mm256_load_pd(x+j), _mm256_load_pd(y+j)));
+		_mm256_store_pd(y+j+4, _mm256_fnmadd_pd(va, _mm256_load_pd(x+j+4), _mm256_load_pd(y+j+4)));
+#else
+		_mm256_store_pd(y+j, _mm256_sub_pd(_mm256_load_pd(y+j), _mm256_mul_pd(va, _mm256_load_pd(x+j))));
+		_mm256_store_pd(y+j+4, _mm256_sub_pd(_mm256_load_pd(y+j+4), _mm256_mul_pd(va, _mm256_load_pd(x+j+4))));
+#endif
+	}
+#elif defined(__SSE2__)
+	for (; j<n && (((size_t)(y+j)) & 15); j++) y[j] -= a*x[j];
+	__m128d va = _mm_set1_pd(a);
+	for (; j+4<=n; j+=4) {
+		_mm_store_pd(y+j, _mm_sub_pd(_mm_load_pd(y+j), _mm_mul_pd(va, _mm_load_pd(x+j))));
+		_mm_store_pd(y+j+2, _mm_sub_pd(_mm_load_pd(y+j+2), _mm_mul_pd(va, _mm_load_pd(x+j+2))));
+	}
+#endif
+	for (; j<n; j++) y[j] -= a*x[j];
+}
+
+// y[0..n-1] *= a
+static inline void tab_scal(double *y, double a, int n) {
+	for (int j=0; j<n; j++) y[j] *= a;
+}
+
+void tableau_pivot(Tableau &t, int p, int q, int r0, int r1, int c0, int c1)
+/*
+ Exchange on the pivot element t[p][q], updating rows r0..r1 and columns c0..c1
+ (inclusive). Rows and columns outside these ranges (labels, auxiliary rows) are
+ left untouched.
+*/
+{
+	int i,jb,nb;
+	double *prow=t[p];
+	double *f=t.f;
+	double rpiv=1.0/prow[q];
+
+	for (i=r0; i<=r1; i++)
+		f[i] = t[i][q]*rpiv;
+	f[p] = 0.0;
+	for (jb=c0; jb<=c1; jb+=TAB_BLOCK) {
+		nb = c1-jb+1 < TAB_BLOCK ? c1-jb+1 : TAB_BLOCK;
+		for (i=r0; i<=r1; i++)
+			if (f[i] != 0.0) tab_axpy(t[i]+jb, prow+jb, f[i], nb);
+	}
+	for (i=r0; i<=r1; i++)
+		t[i][q] = f[i];
+	tab_scal(prow+c0, -rpiv, c1-c0+1);
+	prow[q] = rpiv;
+}
+
+#endif /* _TABLEAU_H_ */
+
+//end of file tableau.h
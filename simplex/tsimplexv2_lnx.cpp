@@ -15,6 +15,10 @@ Begin tsimplexv2.cpp
 #include <sys/times.h>
 #include <sys/vtimes.h>
 #include <sys/resource.h>
+#include "pricing.h"
+#ifdef BASIS_PURSUIT
+#include "bpfront.h"
+#endif
 #include "tsimplexv2-N3-M3-K1.h"
 //#include "tsimplexv2-N10-M6-K1.h"
 //#include "tsimplexv2-N20-M11-K2.h"
@@ -24,9 +28,14 @@ Begin tsimplexv2.cpp
 //#include "tsimplexv2-N256-M80-K8.h"
 using namespace std;
 
+#ifndef PRICING
+#define PRICING PRICE_DANTZIG	// entering column rule, see pricing.h
+#endif
+
 int  IPOSV[MMAX], IZROV[NMAX];
 int  i,j,ICASE;
 REAL R;
+Pricing PR;
 
 void simp1(MAT,int,int *,int,int,int *,REAL *);
 void simp2(MAT,int,int,int *,int,int *,int,REAL *);
@@ -48,6 +57,7 @@ void simplx(MAT a,int m,int n,int m1,int m2,int m3,int *icase,int *izrov, int *i
 		printf(" Bad input constraint counts in simplx.\n");
 		return;
 	}	
+	PR.init(PRICING,a,2,m+1,2,n+1);
 	nl1=n; 
 	for (k=1; k<=n; k++) { 
 		l1[k]=k;     //Initialize index list of columns admissible for exchange.
@@ -110,7 +120,8 @@ e10: simp1(a,m+1,l1,nl1,0,&kp,&bmax);    //Find max. coeff. of auxiliary objecti
 		*icase=-1;                          //unbounded, so no feasible solution exists.
 		return; 
 	} 
-e1: simp3(a,m+1,n,ip,kp); 
+e1: PR.update(a,ip+1,kp+1,2,m+1,2,n+1);
+	simp3(a,m+1,n,ip,kp); 
 	//Exchange a left- and a right-hand variable (phase one), then update lists. 
 	if(iposv[ip] >= n+m1+m2+1) { //Exchanged out an artificial variable for an 
 		//equality constraint. Make sure it stays 
@@ -145,6 +156,7 @@ e30: simp1(a,0,l1,nl1,0,&kp,&bmax); //Test the z-row for doneness.
 		*icase=1; 
 		return; 
 	} 
+	PR.update(a,ip+1,kp+1,2,m+1,2,n+1);
 	simp3(a,m,n,ip,kp);       //Exchange a left- and a right-hand variable (phase two), 
 	goto e20;                 //update lists of left- and right-hand variables and 
 }                           //return for another iteration.
@@ -156,6 +168,10 @@ void simp1(MAT a,int mm,int *ll,int nll,int iabf,int *kp,REAL *bmax) {
 	//ll, either with or without taking the absolute value, as flagged by iabf. 
 	int k; 
 	REAL test; 
+	if (iabf == 0 && PR.rule != PRICE_DANTZIG && nll >= 1) {
+		*kp=PR.select(a[mm+1],ll,1,nll,1,1e-6,bmax)-1;  //Columns are ll[k]+1, tolerance EPS of simplx.
+		return;
+	}
 	*kp=ll[1]; 
 	*bmax=a[mm+1][*kp+1];
 	if (nll < 2) return; 
@@ -267,7 +283,14 @@ int main() {
 	timespec init_time, final_time;
 	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &init_time);
 	
+#ifdef BASIS_PURSUIT
+	// decode x = u - v from Phi and y with the split variable LP
+	double Phi_bp[M*N], y_bp[M];
+	bp_load(Phi,M,N,Phi_bp,y_bp);
+	ICASE = bp_revised(Phi_bp,M,N,y_bp,X_est);
+#else
 	simplx(Phi,M,N,M1,M2,M3,&ICASE,IZROV,IPOSV);
+#endif
 	
 	if (ICASE==0) {  //result ok.
 		//printf("\n ECONOMIC FUNCTION OPTIMIZED: = %f\n\n", Phi[1][1]);
@@ -296,6 +319,7 @@ int main() {
 	
 	//First compute the Mean Square Error, MSE
 
+#ifndef BASIS_PURSUIT
 	for (i=1; i<=N; i++) {
 		X_est[i-1] = 0.0;
 	}
@@ -309,6 +333,7 @@ int main() {
 			}
 	e3a: ;
 	}
+#endif
 
 
 	for (i=0; i<N; i++) {